@@ -0,0 +1,339 @@
+/**
+ * ZION Unified Mining Benchmark
+ *
+ * One harness for all three native algorithm libraries. Replaces the ad-hoc
+ * timing scattered across the tree (the 16-hash sample in randomx_init(),
+ * zion_yescrypt_benchmark(), nothing at all for Cosmic Harmony) with
+ * reproducible timed sweeps whose output two builds can be diffed on.
+ *
+ * The libraries are loaded with dlopen() so one binary benchmarks whichever
+ * .so files a build produced — no link-time dependency on any of them.
+ *
+ * Usage:
+ *   zion-bench --algo cosmic|randomx|yescrypt --lib <path-to-.so>
+ *              [--threads N] [--duration SECONDS] [--batch N]
+ *              [--nonce-dist seq|random] [--key HEX]
+ *
+ * Human-readable progress goes to stderr; the final report is a single JSON
+ * object on stdout (hashes, H/s, per-hash latency p50/p99 in microseconds,
+ * peak RSS) so CI can parse it without scraping.
+ *
+ * @version 2.9.0
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dlfcn.h>
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Entry points resolved from the target library
+// ---------------------------------------------------------------------------
+
+// Cosmic Harmony (libcosmic_harmony_zion)
+typedef bool (*cosmic_initialize_fn)();
+typedef uint32_t (*cosmic_hash_batch_fn)(const uint8_t*, size_t, uint32_t, uint32_t, uint8_t*);
+
+// RandomX (librandomx_zion)
+typedef int (*rx_init_fn)(const char*, int);
+typedef int (*rx_register_thread_fn)();
+typedef uint32_t (*rx_hash_batch_fn)(int, const uint8_t*, size_t, uint32_t, uint8_t*);
+typedef void (*rx_cleanup_fn)();
+
+// Yescrypt (libyescrypt_zion)
+typedef int (*ys_init_fn)(int);
+typedef int (*ys_hash_thread_fn)(int, const uint8_t*, size_t, uint8_t*);
+typedef void (*ys_cleanup_fn)();
+
+struct Options {
+    std::string algo;
+    std::string lib_path;
+    std::string key_hex = "5a494f4e2062656e63686d61726b206b6579";  // "ZION benchmark key"
+    int threads = 1;
+    double duration = 10.0;
+    uint32_t batch = 256;
+    bool random_nonces = false;
+};
+
+struct ThreadResult {
+    uint64_t hashes = 0;
+    std::vector<double> latencies_us;  // per-hash, one sample per batch
+};
+
+double now_s() {
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void* must_sym(void* handle, const char* name) {
+    void* sym = dlsym(handle, name);
+    if (!sym) {
+        std::cerr << "❌ Symbol not found: " << name << " (" << dlerror() << ")" << std::endl;
+        exit(1);
+    }
+    return sym;
+}
+
+// Peak resident set in bytes, from /proc/self/status (VmHWM). Returns 0 on
+// platforms without procfs; the JSON field is then reported as 0.
+uint64_t peak_rss_bytes() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            uint64_t kb = 0;
+            sscanf(line.c_str(), "VmHWM: %lu", (unsigned long*)&kb);
+            return kb * 1024;
+        }
+    }
+    return 0;
+}
+
+// 80-byte header template, deterministic so runs are comparable
+void fill_header(uint8_t* header, size_t len, uint32_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        header[i] = (uint8_t)((i * 0x9E3779B9u + seed) >> 24);
+    }
+}
+
+double percentile(std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t idx = (size_t)(p * (sorted.size() - 1));
+    return sorted[idx];
+}
+
+// ---------------------------------------------------------------------------
+// Per-algorithm worker loops
+//
+// Each loop hashes `batch` nonces per iteration until the deadline, records
+// one per-hash latency sample per batch, and advances the nonce range either
+// sequentially or by a per-thread PRNG (--nonce-dist random approximates the
+// orchestrator's stratified job assignment; sequential shows best-case cache
+// behavior).
+// ---------------------------------------------------------------------------
+
+void run_cosmic(void* handle, const Options& opt, int thread_id,
+                std::atomic<bool>& stop, ThreadResult& result) {
+    auto hash_batch = (cosmic_hash_batch_fn)must_sym(handle, "cosmic_hash_batch");
+
+    uint8_t header[80];
+    fill_header(header, sizeof(header), 0x5A494F4Eu);
+    std::vector<uint8_t> outputs((size_t)opt.batch * 32);
+    std::mt19937 rng(0xC0531Cu + thread_id);
+    uint32_t nonce = (uint32_t)thread_id << 24;
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        double t0 = now_s();
+        hash_batch(header, sizeof(header), nonce, opt.batch, outputs.data());
+        double elapsed = now_s() - t0;
+
+        result.hashes += opt.batch;
+        result.latencies_us.push_back(elapsed * 1e6 / opt.batch);
+        nonce = opt.random_nonces ? rng() : nonce + opt.batch;
+    }
+}
+
+void run_randomx(void* handle, const Options& opt, int thread_id,
+                 std::atomic<bool>& stop, ThreadResult& result) {
+    auto register_thread = (rx_register_thread_fn)must_sym(handle, "zion_randomx_register_thread");
+    auto hash_batch = (rx_hash_batch_fn)must_sym(handle, "zion_randomx_hash_batch");
+
+    if (register_thread() < 0) {
+        std::cerr << "❌ Thread " << thread_id << ": VM registration failed" << std::endl;
+        return;
+    }
+
+    // Batch of headers, contiguous, nonce patched at offset 39 (Monero-style)
+    std::vector<uint8_t> headers((size_t)opt.batch * 80);
+    for (uint32_t i = 0; i < opt.batch; i++) {
+        fill_header(headers.data() + (size_t)i * 80, 80, 0x5A494F4Eu);
+    }
+    std::vector<uint8_t> outputs((size_t)opt.batch * 32);
+    std::mt19937 rng(0xC0531Cu + thread_id);
+    uint32_t nonce = (uint32_t)thread_id << 24;
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        for (uint32_t i = 0; i < opt.batch; i++) {
+            uint32_t n = nonce + i;
+            memcpy(headers.data() + (size_t)i * 80 + 39, &n, 4);
+        }
+
+        double t0 = now_s();
+        hash_batch(-1, headers.data(), 80, opt.batch, outputs.data());
+        double elapsed = now_s() - t0;
+
+        result.hashes += opt.batch;
+        result.latencies_us.push_back(elapsed * 1e6 / opt.batch);
+        nonce = opt.random_nonces ? rng() : nonce + opt.batch;
+    }
+}
+
+void run_yescrypt(void* handle, const Options& opt, int thread_id,
+                  std::atomic<bool>& stop, ThreadResult& result) {
+    auto hash_thread = (ys_hash_thread_fn)must_sym(handle, "yescrypt_hash_bytes_thread");
+
+    uint8_t header[80];
+    fill_header(header, sizeof(header), 0x5A494F4Eu);
+    uint8_t output[32];
+    std::mt19937 rng(0xC0531Cu + thread_id);
+    uint32_t nonce = (uint32_t)thread_id << 24;
+
+    // Yescrypt is ~1ms per hash; batching adds nothing, so `--batch` only
+    // controls how many hashes share one latency sample.
+    while (!stop.load(std::memory_order_relaxed)) {
+        double t0 = now_s();
+        for (uint32_t i = 0; i < opt.batch; i++) {
+            uint32_t n = nonce + i;
+            memcpy(header + 39, &n, 4);
+            if (hash_thread(thread_id, header, sizeof(header), output) != 0) {
+                std::cerr << "❌ Thread " << thread_id << ": hash failed" << std::endl;
+                return;
+            }
+        }
+        double elapsed = now_s() - t0;
+
+        result.hashes += opt.batch;
+        result.latencies_us.push_back(elapsed * 1e6 / opt.batch);
+        nonce = opt.random_nonces ? rng() : nonce + opt.batch;
+    }
+}
+
+void usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " --algo cosmic|randomx|yescrypt --lib <path-to-.so>\n"
+              << "       [--threads N] [--duration SECONDS] [--batch N]\n"
+              << "       [--nonce-dist seq|random] [--key HEX]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) { usage(argv[0]); exit(1); }
+            return argv[++i];
+        };
+        if (arg == "--algo") opt.algo = next();
+        else if (arg == "--lib") opt.lib_path = next();
+        else if (arg == "--threads") opt.threads = atoi(next().c_str());
+        else if (arg == "--duration") opt.duration = atof(next().c_str());
+        else if (arg == "--batch") opt.batch = (uint32_t)atoi(next().c_str());
+        else if (arg == "--nonce-dist") opt.random_nonces = (next() == "random");
+        else if (arg == "--key") opt.key_hex = next();
+        else { usage(argv[0]); return 1; }
+    }
+
+    if (opt.algo.empty() || opt.lib_path.empty() ||
+        opt.threads < 1 || opt.duration <= 0 || opt.batch < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    void* handle = dlopen(opt.lib_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        std::cerr << "❌ dlopen failed: " << dlerror() << std::endl;
+        return 1;
+    }
+
+    // One-time library initialization (outside the timed region — dataset
+    // builds and arena allocation are startup costs, not hash costs)
+    std::cerr << "⏳ Initializing " << opt.algo << " (" << opt.threads << " threads)..." << std::endl;
+    rx_cleanup_fn rx_cleanup = nullptr;
+    ys_cleanup_fn ys_cleanup = nullptr;
+    if (opt.algo == "cosmic") {
+        auto init = (cosmic_initialize_fn)must_sym(handle, "cosmic_harmony_initialize");
+        if (!init()) { std::cerr << "❌ cosmic_harmony_initialize failed" << std::endl; return 1; }
+    } else if (opt.algo == "randomx") {
+        auto init = (rx_init_fn)must_sym(handle, "zion_randomx_init");
+        if (!init(opt.key_hex.c_str(), opt.threads)) {
+            std::cerr << "❌ zion_randomx_init failed" << std::endl;
+            return 1;
+        }
+        rx_cleanup = (rx_cleanup_fn)must_sym(handle, "zion_randomx_cleanup");
+    } else if (opt.algo == "yescrypt") {
+        auto init = (ys_init_fn)must_sym(handle, "yescrypt_init_mining");
+        if (init(opt.threads) != 0) {
+            std::cerr << "❌ yescrypt_init_mining failed" << std::endl;
+            return 1;
+        }
+        ys_cleanup = (ys_cleanup_fn)must_sym(handle, "yescrypt_cleanup");
+    } else {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Timed sweep
+    std::atomic<bool> stop{false};
+    std::vector<ThreadResult> results(opt.threads);
+    std::vector<std::thread> workers;
+    workers.reserve(opt.threads);
+
+    std::cerr << "⏳ Benchmarking for " << opt.duration << "s..." << std::endl;
+    double t_start = now_s();
+    for (int t = 0; t < opt.threads; t++) {
+        if (opt.algo == "cosmic")
+            workers.emplace_back(run_cosmic, handle, std::cref(opt), t,
+                                 std::ref(stop), std::ref(results[t]));
+        else if (opt.algo == "randomx")
+            workers.emplace_back(run_randomx, handle, std::cref(opt), t,
+                                 std::ref(stop), std::ref(results[t]));
+        else
+            workers.emplace_back(run_yescrypt, handle, std::cref(opt), t,
+                                 std::ref(stop), std::ref(results[t]));
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(opt.duration));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& w : workers) w.join();
+    double wall = now_s() - t_start;
+
+    // Aggregate
+    uint64_t total_hashes = 0;
+    std::vector<double> latencies;
+    for (const auto& r : results) {
+        total_hashes += r.hashes;
+        latencies.insert(latencies.end(), r.latencies_us.begin(), r.latencies_us.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    double hashrate = wall > 0 ? (double)total_hashes / wall : 0.0;
+    std::cerr << "✅ " << total_hashes << " hashes in " << wall << "s ("
+              << hashrate << " H/s)" << std::endl;
+
+    // Machine-readable report on stdout
+    std::ostringstream json;
+    json << "{"
+         << "\"algo\":\"" << opt.algo << "\","
+         << "\"lib\":\"" << opt.lib_path << "\","
+         << "\"threads\":" << opt.threads << ","
+         << "\"duration_s\":" << wall << ","
+         << "\"batch\":" << opt.batch << ","
+         << "\"nonce_dist\":\"" << (opt.random_nonces ? "random" : "seq") << "\","
+         << "\"hashes\":" << total_hashes << ","
+         << "\"hashrate_hs\":" << hashrate << ","
+         << "\"latency_p50_us\":" << percentile(latencies, 0.50) << ","
+         << "\"latency_p99_us\":" << percentile(latencies, 0.99) << ","
+         << "\"peak_rss_bytes\":" << peak_rss_bytes()
+         << "}";
+    std::cout << json.str() << std::endl;
+
+    if (rx_cleanup) rx_cleanup();
+    if (ys_cleanup) ys_cleanup();
+    dlclose(handle);
+    return 0;
+}
@@ -1,5 +1,17 @@
 #include "zion-cosmic-harmony.h"
+#include "cosmic_mining_engine.h"
+#include "zion-big256.h"
+#include "zion-cpu.h"
+#include "zion-shmring.h"
+#include "zion-topology.h"
+#include "zion-tune.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
 
 #ifdef _WIN32
     #define ZION_EXPORT __declspec(dllexport)
@@ -13,6 +25,29 @@ ZION_EXPORT void cosmic_hash(const uint8_t* input, size_t input_len, uint32_t no
     zion::CosmicHarmonyHasher::cosmic_hash(input, input_len, nonce, output);
 }
 
+// Eight consecutive nonces (base_nonce .. base_nonce+7) per call,
+// stage-major through the pipeline; outputs receives 8 * 32 bytes. Output
+// lane i is identical to cosmic_hash(input, input_len, base_nonce + i, ...).
+ZION_EXPORT void cosmic_hash_x8(const uint8_t* input, size_t input_len, uint32_t base_nonce,
+                                uint8_t* outputs) {
+    zion::CosmicHarmonyHasher::cosmic_hash_x8(input, input_len, base_nonce, outputs);
+}
+
+// Returns the number of hashes completed; less than count means the sweep
+// was aborted by cosmic_set_job_generation()
+ZION_EXPORT uint32_t cosmic_hash_batch(const uint8_t* input, size_t input_len, uint32_t start_nonce,
+                                       uint32_t count, uint8_t* outputs) {
+    return zion::CosmicHarmonyHasher::cosmic_hash_batch(input, input_len, start_nonce, count, outputs);
+}
+
+// Fixed-size kernel for the production 80-byte block header (76 header
+// bytes + 4-byte nonce appended here). Identical output to
+// cosmic_hash(input, 76, nonce, output); the generic path stays for tests
+// and odd-sized inputs.
+ZION_EXPORT void cosmic_hash80(const uint8_t* header76, uint32_t nonce, uint8_t* output) {
+    zion::CosmicHarmonyHasher::cosmic_hash_fixed<76>(header76, nonce, output);
+}
+
 ZION_EXPORT bool cosmic_harmony_initialize() {
     return zion::CosmicHarmonyHasher::initialize();
 }
@@ -21,4 +56,326 @@ ZION_EXPORT bool check_difficulty(const uint8_t* hash, uint64_t target_difficult
     return zion::CosmicHarmonyHasher::check_difficulty(hash, target_difficulty);
 }
 
+/**
+ * Cached job-target handle (see ZionTarget in zion-big256.h)
+ *
+ * Create once when a job arrives, check every candidate hash against the
+ * handle, destroy on job switch. Skips the per-check target re-parse and
+ * difficulty division of the stateless helpers, and the cached top-64-bit
+ * prefix rejects almost every miss with a single integer compare.
+ */
+ZION_EXPORT void* zion_target_create(const uint8_t* target_be) {
+    if (!target_be) return nullptr;
+    return new ZionTarget(ZionTarget::from_be_bytes(target_be));
+}
+
+// Returns 1 when hash <= target (hash in LE limb order, as produced)
+ZION_EXPORT int zion_target_check(const void* target, const uint8_t* hash) {
+    if (!target || !hash) return 0;
+    return static_cast<const ZionTarget*>(target)->check(hash) ? 1 : 0;
+}
+
+// 64-bit truncated difficulty, precomputed at create time
+ZION_EXPORT uint64_t zion_target_difficulty(const void* target) {
+    return target ? static_cast<const ZionTarget*>(target)->difficulty : 0;
+}
+
+ZION_EXPORT void zion_target_destroy(void* target) {
+    delete static_cast<ZionTarget*>(target);
+}
+
+// Returns 1 if a share was found (found_hash/found_nonce filled in), 0 if the
+// nonce range was exhausted or the sweep was aborted by a job switch.
+// target_be is the 32-byte big-endian target. `completed` (may be NULL)
+// receives the number of nonces hashed; completed < max_iters with no share
+// means the sweep aborted on a generation bump.
+ZION_EXPORT int cosmic_search(const uint8_t* input, size_t input_len, uint32_t start_nonce,
+                              uint32_t max_iters, const uint8_t* target_be,
+                              uint8_t* found_hash, uint32_t* found_nonce, uint32_t* completed) {
+    return zion::CosmicHarmonyHasher::cosmic_search(input, input_len, start_nonce, max_iters,
+                                                    target_be, found_hash, found_nonce,
+                                                    completed) ? 1 : 0;
+}
+
+// Bump when the pool pushes new work: in-flight batch/search sweeps observe
+// the change within ~64 hashes and return early with their completed count
+ZION_EXPORT void cosmic_set_job_generation(uint64_t generation) {
+    zion::cosmic_job_generation().store(generation, std::memory_order_relaxed);
+}
+
+// Core topology snapshot (physical cores, SMT ratio, P/E split, NUMA
+// nodes — see zion-topology.h). Returns 1 on success.
+ZION_EXPORT int zion_topology_query(struct zion_topology* out) {
+    if (!out) return 0;
+    zion::Topology::instance().fill(out);
+    return 1;
+}
+
+// Pin the calling thread to the worker_id-th CPU of the policy's set
+// (ZION_PIN_PHYSICAL / ZION_PIN_PCORE / ZION_PIN_LOGICAL). Returns 1 when
+// the affinity change succeeded.
+ZION_EXPORT int zion_pin_thread(int worker_id, int policy) {
+    return zion::Topology::instance().pin_current(worker_id, policy) ? 1 : 0;
+}
+
+// Detected CPU feature bitmask / readable form (see zion-cpu.h) so the
+// orchestrator can log what each node actually runs
+ZION_EXPORT uint64_t zion_cpu_features() {
+    return zion::cpu_features();
+}
+
+ZION_EXPORT const char* zion_cpu_features_string() {
+    return zion::cpu_features_string();
+}
+
+// Snapshot one worker thread's counters (see zion-stats.h for stage
+// indices). Returns 0 for an out-of-range thread_id.
+ZION_EXPORT int cosmic_get_stats(int thread_id, struct zion_stats* out) {
+    return zion::cosmic_stats_registry().read(thread_id, out);
+}
+
+// One calibrated run of the batch kernel: `threads` workers hashing
+// `batch` nonces per call for `seconds`, returning aggregate H/s.
+static double cosmic_tune_measure(int threads, uint32_t batch, double seconds) {
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> hashes{0};
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            zion::Topology::instance().pin_current(t, zion::tune_pin_policy(threads));
+            uint8_t header[80];
+            for (size_t i = 0; i < sizeof(header); i++) {
+                header[i] = (uint8_t)((i * 0x9E3779B9u + 0x5A494F4Eu) >> 24);
+            }
+            std::vector<uint8_t> outputs((size_t)batch * 32);
+            uint32_t nonce = (uint32_t)t << 24;
+            while (!stop.load(std::memory_order_relaxed)) {
+                zion::CosmicHarmonyHasher::cosmic_hash_batch(header, sizeof(header),
+                                                             nonce, batch, outputs.data());
+                hashes.fetch_add(batch, std::memory_order_relaxed);
+                nonce += batch;
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& w : workers) w.join();
+    return (double)hashes.load() / seconds;
+}
+
+/**
+ * First-run auto-tune (see zion-tune.h)
+ *
+ * Sweeps thread counts, then batch sizes at the winning count, each with a
+ * short calibrated run of the batch kernel, and returns the winner as
+ * fields plus ready-to-persist JSON. Budget is split evenly across the
+ * candidate runs, so `seconds` bounds the total tuning time.
+ */
+ZION_EXPORT int zion_autotune(int seconds, struct zion_tune_result* out) {
+    if (!out || seconds < 1) return -1;
+    if (!zion::CosmicHarmonyHasher::initialize()) return -1;
+
+    const std::vector<int> thread_candidates = zion::tune_thread_candidates();
+    const uint32_t batch_candidates[] = {256, 1024, 4096};
+    const double slice = (double)seconds / (thread_candidates.size() + 3);
+
+    std::cout << "⏳ Cosmic Harmony auto-tune: " << thread_candidates.size()
+              << " thread counts, 3 batch sizes, ~" << seconds << "s total" << std::endl;
+
+    int best_threads = thread_candidates[0];
+    double best_rate = 0.0;
+    for (int threads : thread_candidates) {
+        double rate = cosmic_tune_measure(threads, 1024, slice);
+        std::cout << "   " << threads << " threads: " << (uint64_t)rate << " H/s" << std::endl;
+        if (rate > best_rate) {
+            best_rate = rate;
+            best_threads = threads;
+        }
+    }
+
+    uint32_t best_batch = 1024;
+    for (uint32_t batch : batch_candidates) {
+        double rate = cosmic_tune_measure(best_threads, batch, slice);
+        std::cout << "   batch " << batch << ": " << (uint64_t)rate << " H/s" << std::endl;
+        if (rate > best_rate) {
+            best_rate = rate;
+            best_batch = batch;
+        }
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->threads = best_threads;
+    out->batch = best_batch;
+    out->pin_policy = zion::tune_pin_policy(best_threads);
+    out->full_mem = 0;
+    out->hashrate_hs = best_rate;
+    snprintf(out->config_json, sizeof(out->config_json),
+             "{\"algo\":\"cosmic\",\"threads\":%d,\"batch\":%u,"
+             "\"pin_policy\":%d,\"hashrate_hs\":%.1f}",
+             best_threads, best_batch, out->pin_policy, best_rate);
+
+    std::cout << "✅ Auto-tune winner: " << best_threads << " threads, batch "
+              << best_batch << " (" << (uint64_t)best_rate << " H/s)" << std::endl;
+    return 0;
+}
+
+// Number of stats slots handed out so far (= threads that have hashed)
+ZION_EXPORT int cosmic_get_num_stat_slots() {
+    return zion::cosmic_stats_registry().num_slots();
+}
+
+/**
+ * Share validation pipeline
+ *
+ * One submitted share as seen by the pool backend: the header it claims to
+ * have hashed, the nonce, the hash the miner reported, and the job's target.
+ */
+struct CosmicShareJob {
+    const uint8_t* header;
+    size_t header_len;
+    uint32_t nonce;
+    const uint8_t* claimed_hash;  // 32 bytes
+    const uint8_t* target_be;     // 32 bytes, big-endian
+};
+
+// Verify a burst of submitted shares in one call, parallelized internally.
+// results[i]: 1 = valid share, 0 = hash correct but misses target,
+// -1 = claimed hash does not match the recomputed hash (miner error/fraud).
+ZION_EXPORT void cosmic_verify_batch(const CosmicShareJob* jobs, uint32_t count, int* results) {
+    if (!jobs || !results || count == 0) return;
+
+    // Size the pool like the RandomX wrapper does: hardware concurrency,
+    // but never more threads than shares to verify.
+    unsigned num_workers = std::thread::hardware_concurrency();
+    if (num_workers < 1) num_workers = 1;
+    if (num_workers > count) num_workers = count;
+
+    std::atomic<uint32_t> next_job{0};
+
+    auto verify_worker = [&]() {
+        uint8_t hash[32];
+        for (;;) {
+            uint32_t i = next_job.fetch_add(1);
+            if (i >= count) break;
+
+            const CosmicShareJob& job = jobs[i];
+            if (!job.header || !job.claimed_hash || !job.target_be) {
+                results[i] = -1;
+                continue;
+            }
+
+            zion::CosmicHarmonyHasher::cosmic_hash(job.header, job.header_len, job.nonce, hash);
+
+            if (memcmp(hash, job.claimed_hash, 32) != 0) {
+                results[i] = -1;
+                continue;
+            }
+            results[i] = zion_hash_meets_target(hash, job.target_be) ? 1 : 0;
+        }
+    };
+
+    if (num_workers == 1) {
+        verify_worker();
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(num_workers);
+        for (unsigned t = 0; t < num_workers; t++) {
+            workers.emplace_back(verify_worker);
+        }
+        for (auto& w : workers) {
+            if (w.joinable()) w.join();
+        }
+    }
+}
+
+/**
+ * Multi-threaded mining engine API
+ *
+ * One engine per process: start workers once, submit jobs as the pool pushes
+ * them, and drain found shares with cosmic_engine_poll_share() from a single
+ * consumer thread.
+ */
+
+static zion::CosmicMiningEngine g_engine;
+static zion::ShmRing g_share_ring;
+
+/**
+ * Shared-memory share ring (see zion-shmring.h)
+ *
+ * Create before cosmic_engine_start(): workers then mirror every found
+ * share into their per-thread ring, and the orchestrator drains the file
+ * mapping directly — no per-share FFI callback, no GIL serialization.
+ */
+
+// Returns 1 on success. num_rings must cover the engine thread count —
+// each ring takes exactly one producer, and workers without a ring of
+// their own skip mirroring (the engine warns at start()).
+ZION_EXPORT int zion_ring_create(const char* path, uint32_t num_rings, uint32_t capacity) {
+    if (!g_share_ring.create(path, num_rings, capacity)) return 0;
+    g_engine.set_share_ring(&g_share_ring);
+    return 1;
+}
+
+// Map a ring file created elsewhere (consumer side). Returns 1 on success.
+ZION_EXPORT int zion_ring_attach(const char* path) {
+    return g_share_ring.attach(path) ? 1 : 0;
+}
+
+// Drain up to max records across all rings. Single consumer only.
+ZION_EXPORT uint32_t zion_ring_drain(struct zion_share_record* out, uint32_t max) {
+    return g_share_ring.drain(out, max);
+}
+
+// Records lost to full rings (stalled consumer) since creation
+ZION_EXPORT uint64_t zion_ring_drops() {
+    return g_share_ring.total_drops();
+}
+
+ZION_EXPORT void zion_ring_close() {
+    g_engine.set_share_ring(nullptr);
+    g_share_ring.close();
+}
+
+ZION_EXPORT int cosmic_engine_start(int threads) {
+    return g_engine.start(threads) ? 1 : 0;
+}
+
+// Worker pinning policy (ZION_PIN_*); call before cosmic_engine_start()
+ZION_EXPORT void cosmic_engine_set_pin_policy(int policy) {
+    g_engine.set_pin_policy(policy);
+}
+
+ZION_EXPORT void cosmic_engine_stop() {
+    g_engine.stop();
+}
+
+ZION_EXPORT int cosmic_engine_submit_job(uint64_t job_id, const uint8_t* header,
+                                         size_t header_len, const uint8_t* target_be) {
+    return g_engine.submit_job(job_id, header, header_len, target_be) ? 1 : 0;
+}
+
+// Fills job_id, nonce, thread_id and the 32-byte hash of the next found
+// share. Returns 0 when no share is pending.
+ZION_EXPORT int cosmic_engine_poll_share(uint64_t* job_id, uint32_t* nonce,
+                                         uint32_t* thread_id, uint8_t* hash) {
+    zion::CosmicShareRecord rec;
+    if (!g_engine.poll_share(&rec)) return 0;
+    if (job_id) *job_id = rec.job_id;
+    if (nonce) *nonce = rec.nonce;
+    if (thread_id) *thread_id = rec.thread_id;
+    if (hash) memcpy(hash, rec.hash, 32);
+    return 1;
+}
+
+ZION_EXPORT uint64_t cosmic_engine_total_hashes() {
+    return g_engine.total_hashes();
+}
+
+ZION_EXPORT int cosmic_engine_num_threads() {
+    return g_engine.num_threads();
+}
+
 }
@@ -0,0 +1,181 @@
+#include "cosmic_mining_engine.h"
+#include "zion-cosmic-harmony.h"
+#include "zion-big256.h"
+#include "zion-topology.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace zion {
+
+bool CosmicMiningEngine::start(int threads) {
+    if (m_running.load(std::memory_order_acquire)) {
+        std::cout << "⚠️  CosmicMiningEngine already running" << std::endl;
+        return false;
+    }
+
+    if (threads < 1) threads = 1;
+    if (threads > 64) threads = 64;
+
+    if (!CosmicHarmonyHasher::initialize()) {
+        std::cerr << "❌ CosmicMiningEngine: hasher initialization failed" << std::endl;
+        return false;
+    }
+
+    // The shm ring is strictly single-producer per ring (plain stores on
+    // the head cursor, no CAS): workers beyond the ring count must not
+    // share one, so they fall back to the in-process ring only.
+    if (m_share_ring && m_share_ring->valid() &&
+        (uint32_t)threads > m_share_ring->num_rings()) {
+        std::cout << "⚠️  Share ring has " << m_share_ring->num_rings()
+                  << " rings for " << threads << " workers; workers past ring "
+                  << (m_share_ring->num_rings() - 1)
+                  << " will not mirror shares" << std::endl;
+    }
+
+    m_running.store(true, std::memory_order_release);
+    m_workers.reserve(threads);
+    for (int i = 0; i < threads; i++) {
+        m_workers.emplace_back(&CosmicMiningEngine::worker_loop, this, i);
+    }
+
+    std::cout << "✅ CosmicMiningEngine started with " << threads << " workers" << std::endl;
+    return true;
+}
+
+void CosmicMiningEngine::stop() {
+    if (!m_running.exchange(false, std::memory_order_acq_rel)) return;
+
+    for (auto& w : m_workers) {
+        if (w.joinable()) w.join();
+    }
+    m_workers.clear();
+    std::atomic_store(&m_job, std::shared_ptr<Job>());
+    std::cout << "✅ CosmicMiningEngine stopped" << std::endl;
+}
+
+bool CosmicMiningEngine::submit_job(uint64_t job_id, const uint8_t* header, size_t header_len,
+                                    const uint8_t* target_be) {
+    if (!header || !target_be || header_len == 0) return false;
+
+    auto job = std::make_shared<Job>();
+    job->job_id = job_id;
+    job->header.assign(header, header + header_len);
+    memcpy(job->target_be, target_be, 32);
+
+    // Publish job first, then reset the cursor and bump the generation so
+    // workers that observe the new generation always see the new job too.
+    std::atomic_store(&m_job, job);
+    m_nonce_cursor.store(0, std::memory_order_relaxed);
+    m_job_generation.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+bool CosmicMiningEngine::poll_share(CosmicShareRecord* out) {
+    RingSlot& slot = m_ring[m_ring_tail % RESULT_RING_SIZE];
+    if (!slot.ready.load(std::memory_order_acquire)) return false;
+
+    *out = slot.rec;
+    slot.ready.store(false, std::memory_order_release);
+    m_ring_tail++;
+    return true;
+}
+
+void CosmicMiningEngine::push_share(const CosmicShareRecord& rec) {
+    uint64_t idx = m_ring_head.fetch_add(1, std::memory_order_acq_rel);
+    RingSlot& slot = m_ring[idx % RESULT_RING_SIZE];
+
+    // If the orchestrator has fallen a full ring behind, the oldest share in
+    // this slot is overwritten — shares are retryable, so dropping the stale
+    // one is preferable to blocking the worker.
+    slot.rec = rec;
+    slot.ready.store(true, std::memory_order_release);
+}
+
+void CosmicMiningEngine::worker_loop(int thread_id) {
+    int policy = m_pin_policy.load(std::memory_order_relaxed);
+    if (policy != ZION_PIN_NONE) {
+        if (!Topology::instance().pin_current(thread_id, policy)) {
+            std::cout << "⚠️  Worker " << thread_id << ": CPU pinning failed" << std::endl;
+        }
+    }
+
+    uint64_t seen_generation = 0;
+    std::shared_ptr<Job> job;
+    std::vector<uint8_t> nonce_input;
+    ZionTarget target{};
+
+    CosmicHarmonyHasher::CosmicState state;
+    uint8_t hash[32];
+
+    while (m_running.load(std::memory_order_acquire)) {
+        // Pick up a new job at chunk boundaries.
+        uint64_t gen = m_job_generation.load(std::memory_order_acquire);
+        if (gen != seen_generation || !job) {
+            seen_generation = gen;
+            job = std::atomic_load(&m_job);
+            if (job) {
+                nonce_input.resize(job->header.size() + 4);
+                memcpy(nonce_input.data(), job->header.data(), job->header.size());
+                target = ZionTarget::from_be_bytes(job->target_be);
+            }
+        }
+
+        if (!job) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            continue;
+        }
+
+        // Grab the next chunk from the shared cursor. Idle workers naturally
+        // steal whatever range is next — no per-thread range assignment.
+        uint64_t chunk_start = m_nonce_cursor.fetch_add(NONCE_CHUNK, std::memory_order_relaxed);
+        if (chunk_start > 0xFFFFFFFFull) {
+            // Nonce space exhausted for this job; wait for new work.
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            continue;
+        }
+
+        uint32_t start = (uint32_t)chunk_start;
+        uint64_t end64 = chunk_start + NONCE_CHUNK;
+        uint32_t count = (uint32_t)((end64 > 0x100000000ull ? 0x100000000ull : end64) - chunk_start);
+
+        size_t header_len = job->header.size();
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t nonce = start + i;
+            memcpy(nonce_input.data() + header_len, &nonce, 4);
+
+            memset(&state, 0, sizeof(state));
+            CosmicHarmonyHasher::cosmic_hash_core(nonce_input.data(), nonce_input.size(),
+                                                  nonce, state);
+            CosmicHarmonyHasher::cosmic_fusion(state, hash);
+
+            if (target.check(hash)) {
+                cosmic_stats_registry().slot_for_thread().shares.fetch_add(1, std::memory_order_relaxed);
+                CosmicShareRecord rec;
+                rec.job_id = job->job_id;
+                rec.nonce = nonce;
+                rec.thread_id = (uint32_t)thread_id;
+                memcpy(rec.hash, hash, 32);
+                push_share(rec);
+
+                // Worker i owns ring i exclusively; workers without a ring
+                // of their own skip mirroring (shares still flow through
+                // push_share) rather than violate the SPSC contract.
+                if (m_share_ring && (uint32_t)thread_id < m_share_ring->num_rings()) {
+                    zion_share_record shm_rec;
+                    shm_rec.job_id = job->job_id;
+                    shm_rec.timestamp_us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+                    shm_rec.nonce = nonce;
+                    shm_rec.thread_id = (uint32_t)thread_id;
+                    memcpy(shm_rec.hash, hash, 32);
+                    m_share_ring->push((uint32_t)thread_id, shm_rec);
+                }
+            }
+        }
+
+        m_total_hashes.fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+} // namespace zion
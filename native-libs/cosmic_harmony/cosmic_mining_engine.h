@@ -0,0 +1,116 @@
+/**
+ * ZION Cosmic Harmony Mining Engine
+ *
+ * Native multi-threaded nonce search for Cosmic Harmony. Owns N worker
+ * threads, splits the 32-bit nonce space into chunks handed out from a
+ * lock-free cursor (idle workers steal the next chunk automatically), and
+ * reports found shares through a lock-free result ring drained by the
+ * orchestrator. One job submission saturates all cores — no per-thread job
+ * plumbing in Python.
+ *
+ * @version 2.9.0
+ */
+
+#ifndef ZION_COSMIC_MINING_ENGINE_H
+#define ZION_COSMIC_MINING_ENGINE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "zion-shmring.h"
+
+namespace zion {
+
+// Fixed-size share record pushed by workers, drained by the orchestrator.
+struct CosmicShareRecord {
+    uint64_t job_id;
+    uint32_t nonce;
+    uint32_t thread_id;
+    uint8_t hash[32];
+};
+
+class CosmicMiningEngine {
+public:
+    // Nonces handed to a worker per grab; large enough to amortize the
+    // cursor fetch_add, small enough that job switches stay responsive.
+    static constexpr uint32_t NONCE_CHUNK = 16384;
+    static constexpr size_t RESULT_RING_SIZE = 256;  // power of two
+
+    CosmicMiningEngine() = default;
+    ~CosmicMiningEngine() { stop(); }
+
+    // Spawn `threads` workers (clamped to [1, 64]). Returns false if already
+    // running or worker creation fails.
+    bool start(int threads);
+
+    // Signal workers, join them, and drop the current job.
+    void stop();
+
+    // Publish a new job: all workers abandon their current chunk at the next
+    // chunk boundary and begin sweeping the new header from nonce 0.
+    // target_be is the 32-byte big-endian share target.
+    bool submit_job(uint64_t job_id, const uint8_t* header, size_t header_len,
+                    const uint8_t* target_be);
+
+    // Pop one share from the result ring. Returns false if the ring is empty.
+    bool poll_share(CosmicShareRecord* out);
+
+    // Total hashes completed since start() (all workers, all jobs).
+    uint64_t total_hashes() const { return m_total_hashes.load(std::memory_order_relaxed); }
+
+    bool running() const { return m_running.load(std::memory_order_acquire); }
+    int num_threads() const { return (int)m_workers.size(); }
+
+    // Worker pinning policy (ZION_PIN_* from zion-topology.h). Takes effect
+    // for workers spawned by the next start(); default leaves placement to
+    // the scheduler.
+    void set_pin_policy(int policy) { m_pin_policy.store(policy, std::memory_order_relaxed); }
+
+    // Mirror found shares into a shared-memory ring (one ring per worker,
+    // see zion-shmring.h) so an out-of-process orchestrator can drain them
+    // without FFI polling. The ring must outlive the engine; pass nullptr
+    // to detach. Set while stopped.
+    void set_share_ring(ShmRing* ring) { m_share_ring = ring; }
+
+private:
+    struct Job {
+        uint64_t job_id = 0;
+        std::vector<uint8_t> header;
+        uint8_t target_be[32] = {0};
+    };
+
+    void worker_loop(int thread_id);
+    void push_share(const CosmicShareRecord& rec);
+
+    std::vector<std::thread> m_workers;
+    std::atomic<bool> m_running{false};
+
+    // Current job, swapped atomically on submit_job(). Workers compare the
+    // generation counter at chunk boundaries to pick up new work promptly.
+    std::shared_ptr<Job> m_job;
+    std::atomic<uint64_t> m_job_generation{0};
+
+    // Lock-free chunk cursor over the 32-bit nonce space; reset per job.
+    std::atomic<uint64_t> m_nonce_cursor{0};
+
+    std::atomic<uint64_t> m_total_hashes{0};
+    std::atomic<int> m_pin_policy{0};  // ZION_PIN_NONE
+    ShmRing* m_share_ring = nullptr;
+
+    // MPSC result ring: workers claim a slot with fetch_add and mark it ready;
+    // the single consumer drains in order.
+    struct RingSlot {
+        std::atomic<bool> ready{false};
+        CosmicShareRecord rec;
+    };
+    RingSlot m_ring[RESULT_RING_SIZE];
+    std::atomic<uint64_t> m_ring_head{0};  // next slot to claim (producers)
+    uint64_t m_ring_tail = 0;              // next slot to drain (consumer)
+};
+
+} // namespace zion
+
+#endif // ZION_COSMIC_MINING_ENGINE_H
@@ -1,28 +1,210 @@
 #include "zion-cosmic-harmony.h"
+#include "zion-big256.h"
 #include <iostream>
 #include <cmath>
-// #include <immintrin.h>  // Removed for ARM compatibility - not used in this code
+
+// SIMD backends for the galactic/stellar mixing stages. The transforms are
+// 32/64-byte byte-wise XOR/rotate loops that sit between every pair of
+// digest calls, so each one collapses to a handful of vector ops.
+//
+// On x86 with GCC/Clang the AVX2 kernels are compiled with a target
+// attribute and selected at runtime via zion-cpu.h, so one binary carries
+// both the scalar and vector paths and picks per host. Builds that set
+// -mavx2/-march=native (or MSVC /arch:AVX2) take the vector path
+// unconditionally; AArch64 always has NEON, so that stays compile-time.
+#include "zion-cpu.h"
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define ZION_MIX_DISPATCH 1
+#define ZION_MIX_HAVE_AVX2 1
+#define ZION_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define ZION_MIX_HAVE_AVX2 1
+#define ZION_TARGET_AVX2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace zion {
 
+StatsRegistry& cosmic_stats_registry() {
+    static StatsRegistry registry;
+    return registry;
+}
+
+std::atomic<uint64_t>& cosmic_job_generation() {
+    static std::atomic<uint64_t> generation{0};
+    return generation;
+}
+
 bool CosmicHarmonyHasher::s_initialized = false;
-EVP_MD_CTX* CosmicHarmonyHasher::s_keccak_ctx = nullptr;
-EVP_MD_CTX* CosmicHarmonyHasher::s_sha3_ctx = nullptr;
+const EVP_MD* CosmicHarmonyHasher::s_md_sha3_256 = nullptr;
+const EVP_MD* CosmicHarmonyHasher::s_md_sha3_512 = nullptr;
+
+// RAII holder so each thread's contexts are released when the thread exits.
+namespace {
+struct ThreadEvpCtx {
+    EVP_MD_CTX* ctx = nullptr;
+    ThreadEvpCtx() : ctx(EVP_MD_CTX_new()) {}
+    ~ThreadEvpCtx() { if (ctx) EVP_MD_CTX_free(ctx); }
+};
+// Precomputed mixing masks (pure functions of PHI, identical to the scalar
+// expressions they replace).
+struct MixMasks {
+    uint8_t galactic[32];     // (PHI_UINT64 >> (i % 64)) & 0xFF
+    uint8_t stellar[3][64];   // PHI_UINT32 >> ((wave * 8 + i) % 32)
+    MixMasks() {
+        for (int i = 0; i < 32; i++) {
+            galactic[i] = (uint8_t)((PHI_UINT64 >> (i % 64)) & 0xFF);
+        }
+        for (int wave = 0; wave < 3; wave++) {
+            for (int i = 0; i < 64; i++) {
+                stellar[wave][i] = (uint8_t)(PHI_UINT32 >> ((wave * 8 + i) % 32));
+            }
+        }
+    }
+};
+static const MixMasks s_masks;
+
+// One galactic round over the 32-byte buffer:
+//   b[i] = rol3(b[i] ^ mask[i]), then rotate the whole buffer left one byte
+static void galactic_mix_round_scalar(uint8_t* buf) {
+    for (int i = 0; i < 32; i++) {
+        buf[i] ^= s_masks.galactic[i];
+        buf[i] = ((buf[i] << 3) | (buf[i] >> 5)) & 0xFF;
+    }
+    uint8_t carry = buf[0];
+    for (int i = 0; i < 31; i++) {
+        buf[i] = buf[i + 1];
+    }
+    buf[31] = carry;
+}
+
+// One stellar wave over the 64-byte buffer: b[i] ^= rol1(b[i]); b[i] ^= mask[i]
+static void stellar_mix_wave_scalar(uint8_t* buf, int wave) {
+    for (int i = 0; i < 64; i++) {
+        uint8_t harmonic = buf[i];
+        harmonic ^= (uint8_t)((harmonic << 1) | (harmonic >> 7));
+        harmonic ^= s_masks.stellar[wave][i];
+        buf[i] = harmonic;
+    }
+}
+
+#if defined(ZION_MIX_HAVE_AVX2)
+ZION_TARGET_AVX2 static void galactic_mix_round_avx2(uint8_t* buf) {
+    __m256i x = _mm256_loadu_si256((const __m256i*)buf);
+    x = _mm256_xor_si256(x, _mm256_loadu_si256((const __m256i*)s_masks.galactic));
+    // Per-byte rotate-left-3 via 16-bit shifts + masks (no epi8 shifts in AVX2)
+    __m256i hi = _mm256_and_si256(_mm256_slli_epi16(x, 3), _mm256_set1_epi8((char)0xF8));
+    __m256i lo = _mm256_and_si256(_mm256_srli_epi16(x, 5), _mm256_set1_epi8(0x07));
+    x = _mm256_or_si256(hi, lo);
+    // Rotate the 32 bytes left by one: alignr against the lane-swapped copy
+    __m256i swapped = _mm256_permute2x128_si256(x, x, 0x01);
+    x = _mm256_alignr_epi8(swapped, x, 1);
+    _mm256_storeu_si256((__m256i*)buf, x);
+}
+
+ZION_TARGET_AVX2 static void stellar_mix_wave_avx2(uint8_t* buf, int wave) {
+    for (int half = 0; half < 2; half++) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(buf + half * 32));
+        __m256i hi = _mm256_and_si256(_mm256_slli_epi16(x, 1), _mm256_set1_epi8((char)0xFE));
+        __m256i lo = _mm256_and_si256(_mm256_srli_epi16(x, 7), _mm256_set1_epi8(0x01));
+        x = _mm256_xor_si256(x, _mm256_or_si256(hi, lo));
+        x = _mm256_xor_si256(x, _mm256_loadu_si256((const __m256i*)(s_masks.stellar[wave] + half * 32)));
+        _mm256_storeu_si256((__m256i*)(buf + half * 32), x);
+    }
+}
+#endif
+
+#if defined(__ARM_NEON) && !defined(ZION_MIX_HAVE_AVX2)
+static inline void galactic_mix_round(uint8_t* buf) {
+    uint8x16_t a = vld1q_u8(buf);
+    uint8x16_t b = vld1q_u8(buf + 16);
+    a = veorq_u8(a, vld1q_u8(s_masks.galactic));
+    b = veorq_u8(b, vld1q_u8(s_masks.galactic + 16));
+    a = vorrq_u8(vshlq_n_u8(a, 3), vshrq_n_u8(a, 5));
+    b = vorrq_u8(vshlq_n_u8(b, 3), vshrq_n_u8(b, 5));
+    // Byte rotation across the pair
+    uint8x16_t ra = vextq_u8(a, b, 1);
+    uint8x16_t rb = vextq_u8(b, a, 1);
+    vst1q_u8(buf, ra);
+    vst1q_u8(buf + 16, rb);
+}
+
+static inline void stellar_mix_wave(uint8_t* buf, int wave) {
+    for (int quarter = 0; quarter < 4; quarter++) {
+        uint8x16_t x = vld1q_u8(buf + quarter * 16);
+        uint8x16_t rot = vorrq_u8(vshlq_n_u8(x, 1), vshrq_n_u8(x, 7));
+        x = veorq_u8(x, rot);
+        x = veorq_u8(x, vld1q_u8(s_masks.stellar[wave] + quarter * 16));
+        vst1q_u8(buf + quarter * 16, x);
+    }
+}
+#elif defined(ZION_MIX_DISPATCH)
+// Runtime selection: the pointers are resolved from the CPUID probe on
+// first use and never change afterwards, so the per-call cost is one
+// predictable indirect jump.
+static inline void galactic_mix_round(uint8_t* buf) {
+    static void (*const fn)(uint8_t*) =
+        (zion::cpu_features() & ZION_CPU_AVX2) ? galactic_mix_round_avx2
+                                               : galactic_mix_round_scalar;
+    fn(buf);
+}
+
+static inline void stellar_mix_wave(uint8_t* buf, int wave) {
+    static void (*const fn)(uint8_t*, int) =
+        (zion::cpu_features() & ZION_CPU_AVX2) ? stellar_mix_wave_avx2
+                                               : stellar_mix_wave_scalar;
+    fn(buf, wave);
+}
+#elif defined(ZION_MIX_HAVE_AVX2)
+// Compile-time AVX2 baseline (e.g. MSVC /arch:AVX2): no dispatch needed
+static inline void galactic_mix_round(uint8_t* buf) { galactic_mix_round_avx2(buf); }
+static inline void stellar_mix_wave(uint8_t* buf, int wave) { stellar_mix_wave_avx2(buf, wave); }
+#else
+static inline void galactic_mix_round(uint8_t* buf) { galactic_mix_round_scalar(buf); }
+static inline void stellar_mix_wave(uint8_t* buf, int wave) { stellar_mix_wave_scalar(buf, wave); }
+#endif
+
+} // anonymous namespace
+
+EVP_MD_CTX* CosmicHarmonyHasher::thread_keccak_ctx() {
+    static thread_local ThreadEvpCtx tls_ctx;
+    return tls_ctx.ctx;
+}
+
+EVP_MD_CTX* CosmicHarmonyHasher::thread_sha3_ctx() {
+    static thread_local ThreadEvpCtx tls_ctx;
+    return tls_ctx.ctx;
+}
 
 bool CosmicHarmonyHasher::initialize() {
     if (s_initialized) return true;
-    
-    // Initialize OpenSSL contexts
-    s_keccak_ctx = EVP_MD_CTX_new();
-    s_sha3_ctx = EVP_MD_CTX_new();
-    
-    if (!s_keccak_ctx || !s_sha3_ctx) {
+
+    // Contexts are created per-thread on first use; just verify EVP allocation
+    // works on this platform so failures surface at init rather than mid-sweep.
+    if (!thread_keccak_ctx() || !thread_sha3_ctx()) {
         std::cerr << "Failed to create EVP contexts for ZION Cosmic Harmony" << std::endl;
         return false;
     }
-    
+
+    // Fetch the digest implementations once. These handles live for the
+    // process lifetime and are shared read-only by all hashing threads.
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    s_md_sha3_256 = EVP_MD_fetch(nullptr, "SHA3-256", nullptr);
+    s_md_sha3_512 = EVP_MD_fetch(nullptr, "SHA3-512", nullptr);
+#endif
+    if (!s_md_sha3_256) s_md_sha3_256 = EVP_sha3_256();
+    if (!s_md_sha3_512) s_md_sha3_512 = EVP_sha3_512();
+    if (!s_md_sha3_256 || !s_md_sha3_512) {
+        std::cerr << "Failed to fetch SHA3 digests for ZION Cosmic Harmony" << std::endl;
+        return false;
+    }
+
     s_initialized = true;
-    std::cout << "ZION Cosmic Harmony Algorithm initialized successfully" << std::endl;
+    std::cout << "ZION Cosmic Harmony Algorithm initialized successfully"
+              << " (CPU: " << cpu_features_string() << ")" << std::endl;
     return true;
 }
 
@@ -32,31 +214,156 @@ void CosmicHarmonyHasher::cosmic_hash(const uint8_t* input, size_t input_len,
     cosmic_fusion(state, output);
 }
 
+uint32_t CosmicHarmonyHasher::cosmic_hash_batch(const uint8_t* input, size_t input_len,
+                                              uint32_t start_nonce, uint32_t count,
+                                              uint8_t* outputs) {
+    // Prepare the input buffer once; only the trailing 4 nonce bytes change
+    // between iterations, so the header copy and allocation are amortized
+    // across the whole sweep.
+    std::vector<uint8_t> nonce_input(input_len + 4);
+    memcpy(nonce_input.data(), input, input_len);
+
+    // Poll the job generation every 64 hashes (~100us of work) so a job
+    // switch aborts the sweep promptly instead of draining the batch.
+    const uint64_t entry_gen = cosmic_job_generation().load(std::memory_order_relaxed);
+
+    CosmicState state;
+    for (uint32_t i = 0; i < count; i++) {
+        if ((i & 63) == 63 &&
+            cosmic_job_generation().load(std::memory_order_relaxed) != entry_gen) {
+            return i;
+        }
+
+        uint32_t nonce = start_nonce + i;
+        memcpy(nonce_input.data() + input_len, &nonce, 4);
+
+        memset(&state, 0, sizeof(state));
+        cosmic_hash_core(nonce_input.data(), nonce_input.size(), nonce, state);
+        cosmic_fusion(state, outputs + (size_t)i * 32);
+    }
+    return count;
+}
+
+/**
+ * Eight-lane interleaved pipeline
+ *
+ * Blake3's wide SIMD backends only hit peak throughput on multi-chunk
+ * inputs, but its public API has no multi-message entry point — the
+ * blake3_hash_many() kernel is internal — and stages 2-4 run each lane's
+ * 32/64-byte digest through OpenSSL contexts that are inherently
+ * one-message. So instead of one wide Blake3 call, the lanes are
+ * software-pipelined stage-major: all eight Blake3 hashes back to back,
+ * then all eight galactic rounds, and so on. Each stage's code, mixing
+ * masks, and EVP context stay hot in cache across eight consecutive
+ * invocations, and the vectorized mixing kernels run with no digest calls
+ * interleaved between them — which is where the throughput over eight
+ * independent cosmic_hash() calls comes from.
+ */
+void CosmicHarmonyHasher::cosmic_hash_x8(const uint8_t* input, size_t input_len,
+                                       uint32_t base_nonce, uint8_t* outputs) {
+    // One shared buffer: Blake3 consumes it before the next lane's nonce is
+    // patched in, so the eight lanes never need eight copies of the header.
+    std::vector<uint8_t> nonce_input(input_len + 4);
+    memcpy(nonce_input.data(), input, input_len);
+
+    CosmicState states[8];
+    memset(states, 0, sizeof(states));
+
+    // Stage 1: Blake3 x8
+    for (int lane = 0; lane < 8; lane++) {
+        uint32_t nonce = base_nonce + (uint32_t)lane;
+        memcpy(nonce_input.data() + input_len, &nonce, 4);
+
+        blake3_hasher blake3_ctx;
+        blake3_hasher_init(&blake3_ctx);
+        blake3_hasher_update(&blake3_ctx, nonce_input.data(), nonce_input.size());
+        blake3_hasher_finalize(&blake3_ctx, states[lane].blake3_hash, 32);
+    }
+
+    // Stage 2: galactic mixing + Keccak-256 x8
+    for (int lane = 0; lane < 8; lane++) {
+        galactic_matrix_ops(states[lane].blake3_hash, states[lane].keccak256_hash);
+    }
+
+    // Stage 3: stellar mixing + SHA3-512 x8
+    for (int lane = 0; lane < 8; lane++) {
+        stellar_harmony_process(states[lane].keccak256_hash, states[lane].sha3_512_hash);
+    }
+
+    // Stages 4-5: golden matrix + harmony factor x8
+    for (int lane = 0; lane < 8; lane++) {
+        uint32_t nonce = base_nonce + (uint32_t)lane;
+        golden_matrix_transform(states[lane].sha3_512_hash, states[lane].golden_matrix);
+
+        states[lane].harmony_factor = 0;
+        for (int i = 0; i < 8; i++) {
+            states[lane].harmony_factor ^= (uint32_t)(states[lane].golden_matrix[i] >> 32);
+            states[lane].harmony_factor ^= (uint32_t)(states[lane].golden_matrix[i] & 0xFFFFFFFF);
+        }
+        states[lane].harmony_factor = (states[lane].harmony_factor * PHI_UINT32) ^ nonce;
+        states[lane].cosmic_nonce = nonce;
+    }
+
+    // Final fusion x8
+    for (int lane = 0; lane < 8; lane++) {
+        cosmic_fusion(states[lane], outputs + (size_t)lane * 32);
+    }
+
+    cosmic_stats_registry().slot_for_thread().hashes.fetch_add(8, std::memory_order_relaxed);
+}
+
 CosmicHarmonyHasher::CosmicState CosmicHarmonyHasher::cosmic_hash_advanced(
     const uint8_t* input, size_t input_len, uint32_t nonce) {
-    
+
     CosmicState state;
     memset(&state, 0, sizeof(state));
-    
+
     // Prepare input with nonce
     std::vector<uint8_t> nonce_input(input_len + 4);
     memcpy(nonce_input.data(), input, input_len);
     memcpy(nonce_input.data() + input_len, &nonce, 4);
-    
+
+    cosmic_hash_core(nonce_input.data(), nonce_input.size(), nonce, state);
+
+    return state;
+}
+
+void CosmicHarmonyHasher::cosmic_hash_core(const uint8_t* nonce_input, size_t total_len,
+                                         uint32_t nonce, CosmicState& state) {
+    ThreadStats& stats = cosmic_stats_registry().slot_for_thread();
+    stats.hashes.fetch_add(1, std::memory_order_relaxed);
+
+    // Sample stage latencies on every 64th hash so the EWMA stays fresh
+    // without putting four clock reads on every hash.
+    static thread_local uint32_t sample_countdown = 0;
+    const bool sample = (sample_countdown++ % 64) == 0;
+    double t0 = sample ? StatsRegistry::now_us() : 0.0;
+
     // Stage 1: Blake3 - Quantum Foundation
     blake3_hasher blake3_ctx;
     blake3_hasher_init(&blake3_ctx);
-    blake3_hasher_update(&blake3_ctx, nonce_input.data(), nonce_input.size());
+    blake3_hasher_update(&blake3_ctx, nonce_input, total_len);
     blake3_hasher_finalize(&blake3_ctx, state.blake3_hash, 32);
-    
+
+    double t1 = 0.0;
+    if (sample) { t1 = StatsRegistry::now_us(); StatsRegistry::record_stage(stats, 0, t1 - t0); }
+
     // Stage 2: Galactic Matrix Operations (Keccak-256)
     galactic_matrix_ops(state.blake3_hash, state.keccak256_hash);
+
+    double t2 = 0.0;
+    if (sample) { t2 = StatsRegistry::now_us(); StatsRegistry::record_stage(stats, 1, t2 - t1); }
     
     // Stage 3: Stellar Harmony Processing (SHA3-512)
     stellar_harmony_process(state.keccak256_hash, state.sha3_512_hash);
+
+    double t3 = 0.0;
+    if (sample) { t3 = StatsRegistry::now_us(); StatsRegistry::record_stage(stats, 2, t3 - t2); }
     
     // Stage 4: Golden Ratio Matrix Transformation
     golden_matrix_transform(state.sha3_512_hash, state.golden_matrix);
+
+    if (sample) { StatsRegistry::record_stage(stats, 3, StatsRegistry::now_us() - t3); }
     
     // Stage 5: Compute Harmony Factor
     state.harmony_factor = 0;
@@ -68,45 +375,32 @@ CosmicHarmonyHasher::CosmicState CosmicHarmonyHasher::cosmic_hash_advanced(
     // Apply cosmic resonance
     state.harmony_factor = (state.harmony_factor * PHI_UINT32) ^ nonce;
     state.cosmic_nonce = nonce;
-    
-    return state;
 }
 
 void CosmicHarmonyHasher::galactic_matrix_ops(const uint8_t* input, uint8_t* keccak_output) {
-    if (!s_keccak_ctx) return;
-    
-    // Reset context for Keccak-256
-    EVP_DigestInit_ex(s_keccak_ctx, EVP_shake256(), nullptr);
+    EVP_MD_CTX* keccak_ctx = thread_keccak_ctx();
+    if (!keccak_ctx) return;
     
     // Galactic transformation: input through multiple Keccak rounds
     uint8_t temp_buffer[64];
     memcpy(temp_buffer, input, 32);
     
-    // Apply galactic matrix operations
+    // Apply galactic matrix operations (vectorized golden-ratio mixing +
+    // rotation; bit-identical to the original scalar loops)
     for (int round = 0; round < 4; round++) {
-        // Golden ratio mixing
-        for (int i = 0; i < 32; i++) {
-            temp_buffer[i] ^= (uint8_t)((PHI_UINT64 >> (i % 64)) & 0xFF);
-            temp_buffer[i] = ((temp_buffer[i] << 3) | (temp_buffer[i] >> 5)) & 0xFF;
-        }
-        
-        // Galactic rotation
-        uint8_t carry = temp_buffer[0];
-        for (int i = 0; i < 31; i++) {
-            temp_buffer[i] = temp_buffer[i + 1];
-        }
-        temp_buffer[31] = carry;
+        galactic_mix_round(temp_buffer);
     }
     
-    // Final Keccak-256 computation
-    EVP_DigestInit_ex(s_keccak_ctx, EVP_sha3_256(), nullptr);
-    EVP_DigestUpdate(s_keccak_ctx, temp_buffer, 32);
+    // Final Keccak-256 computation (prefetched MD: no per-hash algorithm fetch)
+    EVP_DigestInit_ex(keccak_ctx, s_md_sha3_256, nullptr);
+    EVP_DigestUpdate(keccak_ctx, temp_buffer, 32);
     unsigned int outlen = 32;
-    EVP_DigestFinal_ex(s_keccak_ctx, keccak_output, &outlen);
+    EVP_DigestFinal_ex(keccak_ctx, keccak_output, &outlen);
 }
 
 void CosmicHarmonyHasher::stellar_harmony_process(const uint8_t* input, uint8_t* sha3_output) {
-    if (!s_sha3_ctx) return;
+    EVP_MD_CTX* sha3_ctx = thread_sha3_ctx();
+    if (!sha3_ctx) return;
     
     // Stellar harmony preprocessing
     uint8_t stellar_input[64];
@@ -117,22 +411,17 @@ void CosmicHarmonyHasher::stellar_harmony_process(const uint8_t* input, uint8_t*
         stellar_input[i] = input[i - 32] ^ (uint8_t)(PHI_UINT64 >> ((i * 8) % 64));
     }
     
-    // Apply stellar wave functions
+    // Apply stellar wave functions (vectorized harmonics, bit-identical to
+    // the original per-byte loop)
     for (int wave = 0; wave < 3; wave++) {
-        for (int i = 0; i < 64; i++) {
-            // Stellar harmonics: sine-based transformation approximated with bit operations
-            uint8_t harmonic = stellar_input[i];
-            harmonic ^= (harmonic << 1) | (harmonic >> 7);
-            harmonic ^= (uint8_t)(PHI_UINT32 >> ((wave * 8 + i) % 32));
-            stellar_input[i] = harmonic;
-        }
+        stellar_mix_wave(stellar_input, wave);
     }
     
-    // Final SHA3-512 computation
-    EVP_DigestInit_ex(s_sha3_ctx, EVP_sha3_512(), nullptr);
-    EVP_DigestUpdate(s_sha3_ctx, stellar_input, 64);
+    // Final SHA3-512 computation (prefetched MD: no per-hash algorithm fetch)
+    EVP_DigestInit_ex(sha3_ctx, s_md_sha3_512, nullptr);
+    EVP_DigestUpdate(sha3_ctx, stellar_input, 64);
     unsigned int outlen = 64;
-    EVP_DigestFinal_ex(s_sha3_ctx, sha3_output, &outlen);
+    EVP_DigestFinal_ex(sha3_ctx, sha3_output, &outlen);
 }
 
 void CosmicHarmonyHasher::golden_matrix_transform(const uint8_t* input, uint64_t* matrix) {
@@ -186,6 +475,48 @@ void CosmicHarmonyHasher::cosmic_fusion(const CosmicState& state, uint8_t* final
     blake3_hasher_finalize(&fusion_hasher, final_hash, 32);
 }
 
+bool CosmicHarmonyHasher::cosmic_search(const uint8_t* input, size_t input_len,
+                                       uint32_t start_nonce, uint32_t max_iters,
+                                       const uint8_t* target_be,
+                                       uint8_t* found_hash, uint32_t* found_nonce,
+                                       uint32_t* completed) {
+    // Same amortization as cosmic_hash_batch: header prepared once, only the
+    // nonce bytes patched per iteration. The target is parsed once up front.
+    std::vector<uint8_t> nonce_input(input_len + 4);
+    memcpy(nonce_input.data(), input, input_len);
+
+    ZionTarget target = ZionTarget::from_be_bytes(target_be);
+    const uint64_t entry_gen = cosmic_job_generation().load(std::memory_order_relaxed);
+
+    CosmicState state;
+    uint8_t hash[32];
+    for (uint32_t i = 0; i < max_iters; i++) {
+        if ((i & 63) == 63 &&
+            cosmic_job_generation().load(std::memory_order_relaxed) != entry_gen) {
+            if (completed) *completed = i;
+            return false;
+        }
+
+        uint32_t nonce = start_nonce + i;
+        memcpy(nonce_input.data() + input_len, &nonce, 4);
+
+        memset(&state, 0, sizeof(state));
+        cosmic_hash_core(nonce_input.data(), nonce_input.size(), nonce, state);
+        cosmic_fusion(state, hash);
+
+        if (target.check(hash)) {
+            cosmic_stats_registry().slot_for_thread().shares.fetch_add(1, std::memory_order_relaxed);
+            memcpy(found_hash, hash, 32);
+            *found_nonce = nonce;
+            if (completed) *completed = i + 1;
+            return true;
+        }
+    }
+
+    if (completed) *completed = max_iters;
+    return false;
+}
+
 bool CosmicHarmonyHasher::check_difficulty(const uint8_t* hash, uint64_t target_difficulty) {
     // Calculate hash difficulty (number of leading zero bits)
     uint64_t hash_difficulty = 0;
@@ -1,21 +1,78 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#define ZION_BSWAP64(x) _byteswap_uint64(x)
+#else
+#define ZION_BSWAP64(x) __builtin_bswap64(x)
+#endif
+
+// Fast paths below assume the limbs can be reinterpreted as four contiguous
+// little-endian 64-bit words; on big-endian targets we keep the portable
+// byte-at-a-time code (see also the hash-divergence notes in the docs).
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_MSC_VER)
+#define ZION_BIG256_LE_FAST 1
+#endif
 
 struct ZionBig256 {
     uint32_t limb[8]{}; // little-endian limbs
     static ZionBig256 from_be_bytes(const uint8_t be[32]){
-        ZionBig256 r; for(int i=0;i<32;i++){ int src=31-i; int li=i/4; int off=i%4; r.limb[li] |= ((uint32_t)be[src]) << (off*8); } return r; }
+        ZionBig256 r;
+#ifdef ZION_BIG256_LE_FAST
+        // Byte-swapped 64-bit loads instead of 32 shift-or iterations
+        for(int w=0;w<4;w++){ uint64_t v; memcpy(&v, be + (3-w)*8, 8); v = ZION_BSWAP64(v); memcpy(&r.limb[w*2], &v, 8); }
+#else
+        for(int i=0;i<32;i++){ int src=31-i; int li=i/4; int off=i%4; r.limb[li] |= ((uint32_t)be[src]) << (off*8); }
+#endif
+        return r; }
     static ZionBig256 from_hash_le(const uint8_t h[32]){
-        ZionBig256 r; for(int i=0;i<32;i++){ int li=i/4; int off=i%4; r.limb[li] |= ((uint32_t)h[i]) << (off*8);} return r; }
+        ZionBig256 r;
+#ifdef ZION_BIG256_LE_FAST
+        memcpy(r.limb, h, 32); // hash bytes are already the LE limb image
+#else
+        for(int i=0;i<32;i++){ int li=i/4; int off=i%4; r.limb[li] |= ((uint32_t)h[i]) << (off*8);}
+#endif
+        return r; }
+    // i-th 64-bit limb (0 = least significant)
+    uint64_t limb64(int i) const {
+#ifdef ZION_BIG256_LE_FAST
+        uint64_t v; memcpy(&v, &limb[i*2], 8); return v;
+#else
+        return (uint64_t)limb[i*2] | ((uint64_t)limb[i*2+1] << 32);
+#endif
+    }
     bool is_zero() const { for(int i=0;i<8;i++) if(limb[i]) return false; return true; }
 };
 
-inline int zion_big256_cmp(const ZionBig256& a, const ZionBig256& b){ for(int i=7;i>=0;--i){ if(a.limb[i]<b.limb[i]) return -1; if(a.limb[i]>b.limb[i]) return 1; } return 0; }
+inline int zion_big256_cmp(const ZionBig256& a, const ZionBig256& b){
+    // Four 64-bit limb comparisons, first-difference selected with ternaries
+    // (compiles to cmov/csel): no early-exit branches for the predictor to
+    // miss in the share validator's hot loop.
+    int r = 0;
+    for(int i=3;i>=0;--i){
+        uint64_t x = a.limb64(i), y = b.limb64(i);
+        int c = (x > y) - (x < y);
+        r = (r == 0) ? c : r;
+    }
+    return r;
+}
 
 inline uint64_t zion_difficulty_from_target(const ZionBig256& t){
     // Precise floor((2^256 - 1) / target) but truncated to 64 bits.
     if(t.is_zero()) return 0;
+    // Fast path: pool targets almost always have their low 128 bits zero
+    // (e.g. the classic 0x00000000ffff0000...0000 diff-1 target). For
+    // t = T << 128, floor((2^256-1)/t) == floor((2^128-1)/T), which a single
+    // __uint128_t division computes without the Knuth long division below.
+    if(t.limb64(0) == 0 && t.limb64(1) == 0){
+        unsigned __int128 T = ((unsigned __int128)t.limb64(3) << 64) | t.limb64(2);
+        unsigned __int128 q = (~(unsigned __int128)0) / T;
+        uint64_t result = (q > (unsigned __int128)~0ULL) ? ~0ULL : (uint64_t)q;
+        if(result==0) result=1; return result;
+    }
     // Represent target and numerator as 16 32-bit limbs (little-endian) for long division.
     // Numerator: all 0xFFFFFFFF (2^256 -1)
     uint32_t denom[8]; for(int i=0;i<8;i++) denom[i]=t.limb[i];
@@ -64,3 +121,38 @@ inline bool zion_hash_meets_target(const uint8_t hash[32], const uint8_t target_
     ZionBig256 t=ZionBig256::from_be_bytes(target_be);
     return zion_big256_cmp(h,t)<=0;
 }
+
+// Cached per-job target state. The stateless helpers above re-parse the
+// 32 target bytes and re-run the difficulty division on every call, but a
+// job's target is fixed for the millions of checks the job lives for —
+// parse and divide once here, then check hashes against the cache. check()
+// also keeps a fast-reject prefix: candidate hashes are uniformly
+// distributed, so almost all of them differ from the target in the top
+// 64 bits and the miss case settles on a single integer compare instead
+// of the four-limb comparison.
+struct ZionTarget {
+    ZionBig256 target;       // parsed once from the big-endian bytes
+    uint64_t difficulty;     // truncated floor((2^256 - 1) / target)
+    uint64_t reject_prefix;  // top 64 bits of the target
+
+    static ZionTarget from_be_bytes(const uint8_t be[32]){
+        ZionTarget t;
+        t.target = ZionBig256::from_be_bytes(be);
+        t.difficulty = zion_difficulty_from_target(t.target);
+        t.reject_prefix = t.target.limb64(3);
+        return t;
+    }
+
+    // True when hash <= target (hash in LE limb order, as produced)
+    bool check(const uint8_t hash_le[32]) const {
+        uint64_t hash_hi;
+#ifdef ZION_BIG256_LE_FAST
+        memcpy(&hash_hi, hash_le + 24, 8);
+#else
+        hash_hi = 0;
+        for(int i=31;i>=24;--i) hash_hi = (hash_hi << 8) | hash_le[i];
+#endif
+        if(hash_hi != reject_prefix) return hash_hi < reject_prefix;
+        return zion_big256_cmp(ZionBig256::from_hash_le(hash_le), target) <= 0;
+    }
+};
@@ -7,9 +7,20 @@
 #include <openssl/evp.h>
 #include <openssl/sha.h>
 #include "blake3.h"  // Fixed include path
+#include "zion-stats.h"
+#include <atomic>
 
 namespace zion {
 
+// Per-thread hashrate/stage-latency counters for this library (see
+// zion-stats.h for the slot model and stage indices)
+StatsRegistry& cosmic_stats_registry();
+
+// Job generation counter polled by the batch/search loops: bump it (via the
+// cosmic_set_job_generation() export) when the pool pushes new work and any
+// in-flight sweep aborts within a few dozen hashes instead of draining.
+std::atomic<uint64_t>& cosmic_job_generation();
+
 // Golden Ratio constants
 constexpr uint32_t PHI_UINT32 = 0x9E3779B9;
 constexpr uint64_t PHI_UINT64 = 0x9E3779B97F4A7C15;
@@ -31,13 +42,30 @@ public:
     static bool initialize();
     
     // Main hashing function
-    static void cosmic_hash(const uint8_t* input, size_t input_len, 
+    static void cosmic_hash(const uint8_t* input, size_t input_len,
                            uint32_t nonce, uint8_t* output);
-    
+
+    // Batch hashing: sweep `count` consecutive nonces starting at `start_nonce`
+    // against the same header. Prepares the input buffer once and patches only
+    // the 4 nonce bytes per iteration. `outputs` must hold count * 32 bytes.
+    // Returns the number of hashes completed — less than `count` when a job
+    // generation bump aborted the sweep early.
+    static uint32_t cosmic_hash_batch(const uint8_t* input, size_t input_len,
+                                     uint32_t start_nonce, uint32_t count,
+                                     uint8_t* outputs);
+
     // Advanced hashing with state
     static CosmicState cosmic_hash_advanced(const uint8_t* input, 
                                            size_t input_len, 
                                            uint32_t nonce);
+
+    // Eight consecutive nonces (base_nonce .. base_nonce+7) through the
+    // pipeline together, stage-major: all eight Blake3 hashes, then all
+    // eight mixing/Keccak rounds, and so on. `outputs` must hold 8 * 32
+    // bytes. See the implementation notes on why the lanes are software-
+    // pipelined rather than fed to a single multi-input Blake3 call.
+    static void cosmic_hash_x8(const uint8_t* input, size_t input_len,
+                              uint32_t base_nonce, uint8_t* outputs);
     
     // Galactic matrix operations (Keccak-256)
     static void galactic_matrix_ops(const uint8_t* input, uint8_t* keccak_output);
@@ -53,11 +81,60 @@ public:
     
     // Check difficulty threshold
     static bool check_difficulty(const uint8_t* hash, uint64_t target_difficulty);
+
+    // In-native nonce search: sweep up to `max_iters` nonces from `start_nonce`
+    // and stop as soon as a hash meets the 256-bit big-endian target. Returns
+    // true on a share (found_hash/found_nonce filled in), false if the range
+    // was exhausted. Runs the whole loop in C++ so callers pay one FFI
+    // crossing per sweep instead of two per nonce.
+    // `completed` (optional) receives the number of nonces hashed; when it
+    // is below max_iters and no share was found, the sweep was aborted by a
+    // job generation bump.
+    static bool cosmic_search(const uint8_t* input, size_t input_len,
+                             uint32_t start_nonce, uint32_t max_iters,
+                             const uint8_t* target_be,
+                             uint8_t* found_hash, uint32_t* found_nonce,
+                             uint32_t* completed = nullptr);
     
+    // Core pipeline over an already-prepared input buffer (header + nonce
+    // bytes). Low-level entry used by the batch/search paths and the native
+    // mining engine; most callers want cosmic_hash() instead.
+    static void cosmic_hash_core(const uint8_t* nonce_input, size_t total_len,
+                                uint32_t nonce, CosmicState& state);
+
+    // Compile-time-sized variant for the production case where every input
+    // is the fixed-length block header. The working buffer lives on the
+    // stack, the nonce offset is a constant, and the copies below compile to
+    // straight-line stores — no vector allocation on the path that runs a
+    // trillion times. kHeaderLen excludes the 4 appended nonce bytes.
+    template <size_t kHeaderLen>
+    static void cosmic_hash_fixed(const uint8_t* input, uint32_t nonce, uint8_t* output) {
+        uint8_t buf[kHeaderLen + 4];
+        memcpy(buf, input, kHeaderLen);
+        memcpy(buf + kHeaderLen, &nonce, 4);
+
+        CosmicState state;
+        memset(&state, 0, sizeof(state));
+        cosmic_hash_core(buf, kHeaderLen + 4, nonce, state);
+        cosmic_fusion(state, output);
+    }
+
 private:
+    // Per-thread EVP contexts: each mining thread gets its own pair, created
+    // lazily on first use, so cosmic_hash() is safe to call concurrently from
+    // the full worker pool without locking.
+    static EVP_MD_CTX* thread_keccak_ctx();
+    static EVP_MD_CTX* thread_sha3_ctx();
+
     static bool s_initialized;
-    static EVP_MD_CTX* s_keccak_ctx;
-    static EVP_MD_CTX* s_sha3_ctx;
+
+    // Digest handles fetched once at initialize(). On OpenSSL 3.x every
+    // EVP_DigestInit_ex with a builtin EVP_sha3_*() does an implicit
+    // algorithm fetch + parameter negotiation that costs more than the
+    // 32-byte permutation itself; initializing from an explicitly fetched
+    // EVP_MD skips all of that on the steady-state hash loop.
+    static const EVP_MD* s_md_sha3_256;
+    static const EVP_MD* s_md_sha3_512;
 };
 
 } // namespace zion
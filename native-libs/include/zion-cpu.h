@@ -0,0 +1,81 @@
+/**
+ * ZION runtime CPU feature detection
+ *
+ * One probe at first use, shared by the three native libraries, so kernel
+ * selection happens at load time instead of build time: one fat binary
+ * carries every variant and each node runs the best path its silicon
+ * supports. Each wrapper exports zion_cpu_features() /
+ * zion_cpu_features_string() built on this so the orchestrator can log what
+ * a node is actually running.
+ *
+ * Blake3 ships its own runtime dispatch (blake3_dispatch.c probes CPUID
+ * internally), so only our own kernels consult this module.
+ *
+ * @version 2.9.0
+ */
+
+#pragma once
+#include <cstdint>
+
+// Feature bits returned by zion::cpu_features() and the C exports
+#define ZION_CPU_SSE2    (1ull << 0)
+#define ZION_CPU_SSE41   (1ull << 1)
+#define ZION_CPU_AVX2    (1ull << 2)
+#define ZION_CPU_AVX512F (1ull << 3)
+#define ZION_CPU_AES     (1ull << 4)
+#define ZION_CPU_NEON    (1ull << 5)
+
+namespace zion {
+
+namespace detail {
+inline uint64_t probe_cpu_features() {
+    uint64_t features = 0;
+#if defined(__x86_64__) || defined(__i386__)
+    // __builtin_cpu_supports reads CPUID (and XCR0 for the AVX bits, so an
+    // OS that doesn't save the wide registers correctly reports "no")
+    if (__builtin_cpu_supports("sse2"))     features |= ZION_CPU_SSE2;
+    if (__builtin_cpu_supports("sse4.1"))   features |= ZION_CPU_SSE41;
+    if (__builtin_cpu_supports("avx2"))     features |= ZION_CPU_AVX2;
+    if (__builtin_cpu_supports("avx512f"))  features |= ZION_CPU_AVX512F;
+    if (__builtin_cpu_supports("aes"))      features |= ZION_CPU_AES;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    // AdvSIMD is architecturally mandatory on AArch64
+    features |= ZION_CPU_NEON;
+#elif defined(__ARM_NEON)
+    features |= ZION_CPU_NEON;
+#endif
+    return features;
+}
+} // namespace detail
+
+// Probed once, cached for the process lifetime
+inline uint64_t cpu_features() {
+    static const uint64_t features = detail::probe_cpu_features();
+    return features;
+}
+
+// Static human-readable form for logs, e.g. "sse2 sse4.1 avx2 aes"
+inline const char* cpu_features_string() {
+    static char buf[64];
+    static bool built = false;
+    if (!built) {
+        uint64_t f = cpu_features();
+        char* p = buf;
+        auto append = [&](const char* name) {
+            for (const char* c = name; *c; c++) *p++ = *c;
+            *p++ = ' ';
+        };
+        if (f & ZION_CPU_SSE2)    append("sse2");
+        if (f & ZION_CPU_SSE41)   append("sse4.1");
+        if (f & ZION_CPU_AVX2)    append("avx2");
+        if (f & ZION_CPU_AVX512F) append("avx512f");
+        if (f & ZION_CPU_AES)     append("aes");
+        if (f & ZION_CPU_NEON)    append("neon");
+        if (p > buf) p--;  // drop trailing space
+        *p = '\0';
+        built = true;
+    }
+    return buf;
+}
+
+} // namespace zion
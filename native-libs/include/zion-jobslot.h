@@ -0,0 +1,68 @@
+/**
+ * ZION zero-copy job buffers
+ *
+ * The orchestrator registers a persistent buffer once, rewrites header bytes
+ * in place (from Python, through a writable memoryview over the same memory),
+ * and triggers hashing with an index-only call. No per-call allocation, no
+ * hex parsing, no copies across the FFI boundary — the hash reads straight
+ * out of the registered memory.
+ *
+ * The table is a fixed array of slots claimed with CAS, so registration is
+ * safe from any thread and the lookup on the hash path is a single relaxed
+ * load. The caller owns the memory and must keep it valid (and must not
+ * resize it) until the slot is unregistered.
+ *
+ * @version 2.9.0
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#define ZION_JOBSLOT_MAX 16
+
+namespace zion {
+
+class JobSlotTable {
+public:
+    // Claim a free slot for `ptr`/`len`. Returns the slot index, or -1 when
+    // the table is full or the arguments are invalid.
+    int register_buffer(const uint8_t* ptr, size_t len) {
+        if (!ptr || len == 0) return -1;
+        for (int i = 0; i < ZION_JOBSLOT_MAX; i++) {
+            const uint8_t* expected = nullptr;
+            if (m_slots[i].ptr.compare_exchange_strong(expected, ptr,
+                                                       std::memory_order_acq_rel)) {
+                m_slots[i].len.store(len, std::memory_order_release);
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // Release a slot. Returns 1 on success, 0 for an empty or bad index.
+    int unregister(int slot) {
+        if (slot < 0 || slot >= ZION_JOBSLOT_MAX) return 0;
+        m_slots[slot].len.store(0, std::memory_order_relaxed);
+        return m_slots[slot].ptr.exchange(nullptr, std::memory_order_acq_rel) ? 1 : 0;
+    }
+
+    // Resolve a slot for hashing. Returns the buffer, or nullptr when the
+    // slot is empty or `want_len` overruns the registered length.
+    const uint8_t* resolve(int slot, size_t want_len) const {
+        if (slot < 0 || slot >= ZION_JOBSLOT_MAX) return nullptr;
+        const uint8_t* ptr = m_slots[slot].ptr.load(std::memory_order_acquire);
+        if (!ptr || want_len > m_slots[slot].len.load(std::memory_order_relaxed)) return nullptr;
+        return ptr;
+    }
+
+private:
+    struct Slot {
+        std::atomic<const uint8_t*> ptr{nullptr};
+        std::atomic<size_t> len{0};
+    };
+    Slot m_slots[ZION_JOBSLOT_MAX];
+};
+
+} // namespace zion
@@ -0,0 +1,216 @@
+/**
+ * ZION shared-memory share-result rings
+ *
+ * Streams found shares from native worker threads to the orchestrator
+ * without FFI callbacks: one single-producer/single-consumer ring per
+ * worker thread in a file-backed shared mapping. Workers append fixed-size
+ * records with release stores; the orchestrator (same process via
+ * zion_ring_drain(), or Python mmap'ing the same file) drains with acquire
+ * loads — no syscalls, no copies into callback arguments, no GIL stalls
+ * serializing the workers.
+ *
+ * On-disk layout: one ShmRingFileHeader, then num_rings rings, each a
+ * cache-line-padded head/tail/drops header followed by capacity records.
+ * capacity must be a power of two. When a ring is full the producer drops
+ * the new record and counts it — shares are retryable and a stalled
+ * consumer must never block the hash loop.
+ *
+ * @version 2.9.0
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Fixed-size record (plain POD, stable layout for Python struct parsing)
+extern "C" {
+struct zion_share_record {
+    uint64_t job_id;
+    uint64_t timestamp_us;   // wall clock, microseconds since epoch
+    uint32_t nonce;
+    uint32_t thread_id;
+    uint8_t hash[32];
+};
+}
+
+namespace zion {
+
+struct ShmRingFileHeader {
+    char magic[4];        // "ZSHR"
+    uint32_t version;     // 1
+    uint32_t num_rings;
+    uint32_t capacity;    // records per ring, power of two
+    uint64_t ring_stride; // bytes from one ring header to the next
+};
+
+struct ShmRingHeader {
+    alignas(64) std::atomic<uint64_t> head;   // producer cursor
+    alignas(64) std::atomic<uint64_t> tail;   // consumer cursor
+    alignas(64) std::atomic<uint64_t> drops;  // records lost to a full ring
+};
+
+class ShmRing {
+public:
+    ~ShmRing() { close(); }
+
+    // Create (or truncate) the backing file and map it. One ring per
+    // expected producer thread; capacity is rounded up to a power of two.
+    bool create(const char* path, uint32_t num_rings, uint32_t capacity) {
+#ifdef __linux__
+        close();
+        if (!path || num_rings == 0 || capacity == 0) return false;
+
+        uint32_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+
+        const uint64_t stride = sizeof(ShmRingHeader) + (uint64_t)cap * sizeof(zion_share_record);
+        const uint64_t total = sizeof(ShmRingFileHeader) + (uint64_t)num_rings * stride;
+
+        int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        if (ftruncate(fd, (off_t)total) != 0) { ::close(fd); return false; }
+
+        void* map = mmap(nullptr, (size_t)total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) return false;
+
+        memset(map, 0, (size_t)total);
+        auto* hdr = static_cast<ShmRingFileHeader*>(map);
+        memcpy(hdr->magic, "ZSHR", 4);
+        hdr->version = 1;
+        hdr->num_rings = num_rings;
+        hdr->capacity = cap;
+        hdr->ring_stride = stride;
+
+        m_map = map;
+        m_size = (size_t)total;
+        return true;
+#else
+        (void)path; (void)num_rings; (void)capacity;
+        return false;
+#endif
+    }
+
+    // Map an existing ring file created by another process.
+    bool attach(const char* path) {
+#ifdef __linux__
+        close();
+        if (!path) return false;
+
+        int fd = open(path, O_RDWR);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ShmRingFileHeader)) {
+            ::close(fd);
+            return false;
+        }
+
+        void* map = mmap(nullptr, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) return false;
+
+        const auto* hdr = static_cast<const ShmRingFileHeader*>(map);
+        if (memcmp(hdr->magic, "ZSHR", 4) != 0 || hdr->version != 1) {
+            munmap(map, (size_t)st.st_size);
+            return false;
+        }
+
+        m_map = map;
+        m_size = (size_t)st.st_size;
+        return true;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    void close() {
+#ifdef __linux__
+        if (m_map) munmap(m_map, m_size);
+#endif
+        m_map = nullptr;
+        m_size = 0;
+    }
+
+    bool valid() const { return m_map != nullptr; }
+    uint32_t num_rings() const { return valid() ? header()->num_rings : 0; }
+
+    // Producer side: append one record to ring_index's ring. Each ring must
+    // have exactly one producer thread. Returns false (and counts a drop)
+    // when the consumer has fallen a full ring behind.
+    bool push(uint32_t ring_index, const zion_share_record& rec) {
+        ShmRingHeader* ring = ring_header(ring_index);
+        if (!ring) return false;
+
+        const uint32_t cap = header()->capacity;
+        uint64_t head = ring->head.load(std::memory_order_relaxed);
+        uint64_t tail = ring->tail.load(std::memory_order_acquire);
+        if (head - tail >= cap) {
+            ring->drops.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        records(ring_index)[head & (cap - 1)] = rec;
+        ring->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: drain up to max records across all rings (single
+    // consumer). Returns the number of records copied into out.
+    uint32_t drain(zion_share_record* out, uint32_t max) {
+        if (!valid() || !out || max == 0) return 0;
+
+        uint32_t copied = 0;
+        const uint32_t cap = header()->capacity;
+        for (uint32_t r = 0; r < header()->num_rings && copied < max; r++) {
+            ShmRingHeader* ring = ring_header(r);
+            uint64_t head = ring->head.load(std::memory_order_acquire);
+            uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            while (tail < head && copied < max) {
+                out[copied++] = records(r)[tail & (cap - 1)];
+                tail++;
+            }
+            ring->tail.store(tail, std::memory_order_release);
+        }
+        return copied;
+    }
+
+    // Records lost to full rings since creation, summed over all rings.
+    uint64_t total_drops() const {
+        if (!valid()) return 0;
+        uint64_t drops = 0;
+        for (uint32_t r = 0; r < header()->num_rings; r++) {
+            drops += const_cast<ShmRing*>(this)->ring_header(r)->drops.load(std::memory_order_relaxed);
+        }
+        return drops;
+    }
+
+private:
+    const ShmRingFileHeader* header() const {
+        return static_cast<const ShmRingFileHeader*>(m_map);
+    }
+
+    ShmRingHeader* ring_header(uint32_t ring_index) {
+        if (!valid() || ring_index >= header()->num_rings) return nullptr;
+        uint8_t* base = static_cast<uint8_t*>(m_map) + sizeof(ShmRingFileHeader);
+        return reinterpret_cast<ShmRingHeader*>(base + ring_index * header()->ring_stride);
+    }
+
+    zion_share_record* records(uint32_t ring_index) {
+        uint8_t* base = reinterpret_cast<uint8_t*>(ring_header(ring_index));
+        return reinterpret_cast<zion_share_record*>(base + sizeof(ShmRingHeader));
+    }
+
+    void* m_map = nullptr;
+    size_t m_size = 0;
+};
+
+} // namespace zion
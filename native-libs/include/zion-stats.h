@@ -0,0 +1,105 @@
+/**
+ * ZION lock-free mining instrumentation
+ *
+ * Always-on per-thread counters shared by the three native algorithm
+ * libraries: hashes completed, shares found, and an EWMA of per-stage
+ * latency. Each worker thread owns one cache-line-padded slot and updates it
+ * with relaxed atomics (no locks, no contention); readers snapshot slots at
+ * any time for second-granularity hashrate telemetry instead of estimating
+ * fleet throughput from submitted shares.
+ *
+ * Stage indices are algorithm-specific:
+ *   Cosmic Harmony: 0=Blake3  1=Keccak  2=SHA3-512  3=golden matrix
+ *   RandomX:        0=VM hash
+ *   Yescrypt:       0=KDF
+ *
+ * @version 2.9.0
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#define ZION_STATS_MAX_THREADS 64
+#define ZION_STATS_MAX_STAGES 4
+
+// Snapshot handed across the C API (plain POD for ctypes)
+extern "C" {
+struct zion_stats {
+    uint64_t hashes;                            // hashes completed
+    uint64_t shares;                            // shares found
+    double stage_ewma_us[ZION_STATS_MAX_STAGES]; // smoothed stage latency (µs)
+};
+}
+
+namespace zion {
+
+// One slot per worker thread, padded so neighbouring threads never share a
+// cache line. The owning thread is the only writer; relaxed ordering is
+// enough because readers only want a recent snapshot, not a consistent cut.
+struct alignas(64) ThreadStats {
+    std::atomic<uint64_t> hashes{0};
+    std::atomic<uint64_t> shares{0};
+    // EWMA values stored as double bit patterns so they stay lock-free
+    std::atomic<uint64_t> stage_ewma_bits[ZION_STATS_MAX_STAGES] = {};
+};
+
+class StatsRegistry {
+public:
+    // The calling thread's slot, assigned on first use. Slots are never
+    // recycled; past ZION_STATS_MAX_THREADS everyone shares the last slot
+    // (counters stay valid, attribution degrades).
+    ThreadStats& slot_for_thread() {
+        static thread_local int tls_slot = -1;
+        if (tls_slot < 0) {
+            int idx = m_next_slot.fetch_add(1, std::memory_order_relaxed);
+            if (idx >= ZION_STATS_MAX_THREADS) idx = ZION_STATS_MAX_THREADS - 1;
+            tls_slot = idx;
+        }
+        return m_slots[tls_slot];
+    }
+
+    // Snapshot one slot into the C struct. Returns 0 on bad thread_id.
+    int read(int thread_id, zion_stats* out) const {
+        if (!out || thread_id < 0 || thread_id >= ZION_STATS_MAX_THREADS) return 0;
+        const ThreadStats& s = m_slots[thread_id];
+        out->hashes = s.hashes.load(std::memory_order_relaxed);
+        out->shares = s.shares.load(std::memory_order_relaxed);
+        for (int i = 0; i < ZION_STATS_MAX_STAGES; i++) {
+            uint64_t bits = s.stage_ewma_bits[i].load(std::memory_order_relaxed);
+            double v;
+            memcpy(&v, &bits, 8);
+            out->stage_ewma_us[i] = v;
+        }
+        return 1;
+    }
+
+    int num_slots() const {
+        int n = m_next_slot.load(std::memory_order_relaxed);
+        return n > ZION_STATS_MAX_THREADS ? ZION_STATS_MAX_THREADS : n;
+    }
+
+    static double now_us() {
+        return std::chrono::duration<double, std::micro>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // EWMA with alpha = 1/16; only ever called by the slot's owner thread.
+    static void record_stage(ThreadStats& s, int stage, double us) {
+        if (stage < 0 || stage >= ZION_STATS_MAX_STAGES) return;
+        uint64_t bits = s.stage_ewma_bits[stage].load(std::memory_order_relaxed);
+        double ewma;
+        memcpy(&ewma, &bits, 8);
+        ewma = (ewma == 0.0) ? us : ewma + (us - ewma) * (1.0 / 16.0);
+        memcpy(&bits, &ewma, 8);
+        s.stage_ewma_bits[stage].store(bits, std::memory_order_relaxed);
+    }
+
+private:
+    ThreadStats m_slots[ZION_STATS_MAX_THREADS];
+    std::atomic<int> m_next_slot{0};
+};
+
+} // namespace zion
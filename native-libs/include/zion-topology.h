@@ -0,0 +1,169 @@
+/**
+ * ZION core-topology enumeration and worker pinning
+ *
+ * Thread placement has been left to the Python caller, so on SMT and hybrid
+ * (P/E-core) machines the scheduler migrates miners between core types and
+ * hashrate jitters run to run. This module enumerates the topology once from
+ * sysfs — logical CPUs, physical cores, SMT siblings, P/E core sets, NUMA
+ * nodes — and pins worker threads by policy:
+ *
+ *   ZION_PIN_NONE      leave placement to the scheduler
+ *   ZION_PIN_PHYSICAL  one worker per physical core (skip SMT siblings) —
+ *                      right for RandomX, where two SMT threads fight over
+ *                      one core's scratchpad bandwidth
+ *   ZION_PIN_PCORE     performance cores only (hybrid Intel; falls back to
+ *                      ZION_PIN_PHYSICAL when cores are homogeneous)
+ *   ZION_PIN_LOGICAL   round-robin over all logical CPUs
+ *
+ * The wrappers export this as zion_topology_query() / zion_pin_thread().
+ * Non-Linux platforms report a minimal topology and pinning is a no-op.
+ *
+ * @version 2.9.0
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#define ZION_PIN_NONE     0
+#define ZION_PIN_PHYSICAL 1
+#define ZION_PIN_PCORE    2
+#define ZION_PIN_LOGICAL  3
+
+// Snapshot handed across the C API (plain POD for ctypes)
+extern "C" {
+struct zion_topology {
+    int logical_cpus;
+    int physical_cores;
+    int smt_ratio;       // logical CPUs per physical core (1 = no SMT)
+    int numa_nodes;
+    int p_cores;         // performance cores (0 when homogeneous/unknown)
+    int e_cores;         // efficiency cores  (0 when homogeneous/unknown)
+};
+}
+
+namespace zion {
+
+class Topology {
+public:
+    // Enumerated once on first use; topology doesn't change at runtime
+    static const Topology& instance() {
+        static Topology topo;
+        return topo;
+    }
+
+    void fill(zion_topology* out) const {
+        if (!out) return;
+        out->logical_cpus = (int)m_all_cpus.size();
+        out->physical_cores = (int)m_core_primaries.size();
+        out->smt_ratio = m_core_primaries.empty()
+                             ? 1 : (int)(m_all_cpus.size() / m_core_primaries.size());
+        out->numa_nodes = m_numa_nodes;
+        out->p_cores = (int)m_pcore_cpus.size();
+        out->e_cores = (int)m_ecore_cpus.size();
+    }
+
+    // Pin the calling thread to the worker_id-th CPU of the policy's set
+    // (wrapping around). Returns true when the affinity call succeeded.
+    bool pin_current(int worker_id, int policy) const {
+        if (policy == ZION_PIN_NONE || worker_id < 0) return false;
+#ifdef __linux__
+        const std::vector<int>* cpus = &m_all_cpus;
+        if (policy == ZION_PIN_PHYSICAL) {
+            cpus = &m_core_primaries;
+        } else if (policy == ZION_PIN_PCORE) {
+            // Homogeneous machines have no P/E split; fall back to physical
+            cpus = m_pcore_cpus.empty() ? &m_core_primaries : &m_pcore_cpus;
+        }
+        if (cpus->empty()) return false;
+
+        int cpu = (*cpus)[(size_t)worker_id % cpus->size()];
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)worker_id;
+        return false;
+#endif
+    }
+
+private:
+    Topology() {
+#ifdef __linux__
+        // Physical cores: first logical CPU seen per (package, core_id) pair
+        std::vector<long> seen_cores;
+        for (int cpu = 0; cpu < 4096; cpu++) {
+            std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+            std::ifstream core_f(base + "/topology/core_id");
+            if (!core_f.good()) break;
+            m_all_cpus.push_back(cpu);
+
+            long core_id = -1, pkg_id = 0;
+            core_f >> core_id;
+            std::ifstream pkg_f(base + "/topology/physical_package_id");
+            if (pkg_f.good()) pkg_f >> pkg_id;
+
+            long key = (pkg_id << 20) | core_id;
+            bool first = true;
+            for (long k : seen_cores) {
+                if (k == key) { first = false; break; }
+            }
+            if (first) {
+                seen_cores.push_back(key);
+                m_core_primaries.push_back(cpu);
+            }
+        }
+
+        // Hybrid Intel exposes the split as cpu_core/cpu_atom CPU lists
+        m_pcore_cpus = parse_cpulist_file("/sys/devices/cpu_core/cpus");
+        m_ecore_cpus = parse_cpulist_file("/sys/devices/cpu_atom/cpus");
+
+        for (int node = 0; node < 64; node++) {
+            std::ifstream f("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!f.good()) break;
+            m_numa_nodes++;
+        }
+        if (m_numa_nodes == 0) m_numa_nodes = 1;
+#else
+        m_numa_nodes = 1;
+#endif
+    }
+
+    // Parse a sysfs cpulist ("0-3,8,10-11") into CPU numbers
+    static std::vector<int> parse_cpulist_file(const std::string& path) {
+        std::vector<int> cpus;
+        std::ifstream f(path);
+        if (!f.good()) return cpus;
+        std::string list;
+        std::getline(f, list);
+        std::stringstream ss(list);
+        std::string range;
+        while (std::getline(ss, range, ',')) {
+            int lo = 0, hi = 0;
+            if (sscanf(range.c_str(), "%d-%d", &lo, &hi) == 2) {
+                for (int c = lo; c <= hi; c++) cpus.push_back(c);
+            } else if (sscanf(range.c_str(), "%d", &lo) == 1) {
+                cpus.push_back(lo);
+            }
+        }
+        return cpus;
+    }
+
+    std::vector<int> m_all_cpus;
+    std::vector<int> m_core_primaries;
+    std::vector<int> m_pcore_cpus;
+    std::vector<int> m_ecore_cpus;
+    int m_numa_nodes = 0;
+};
+
+} // namespace zion
@@ -0,0 +1,74 @@
+/**
+ * ZION first-run auto-tuning
+ *
+ * Thread counts, batch sizes, pinning, and FULL_MEM vs light mode have all
+ * been manual knobs, maintained as brittle per-SKU config files. Each
+ * library instead exports zion_autotune(seconds, result): short calibrated
+ * sweeps of its own engine against measured H/s, with the winning
+ * configuration returned both as fields and as ready-to-persist JSON that
+ * the orchestrator can feed back into subsequent inits. A few minutes of
+ * first-run tuning beats a permanently misconfigured node losing 20%.
+ *
+ * This header holds the shared result struct and the host-derived
+ * candidate list; the measurement loops live with each engine.
+ *
+ * @version 2.9.0
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "zion-topology.h"
+
+// Winning configuration (plain POD for ctypes)
+extern "C" {
+struct zion_tune_result {
+    int threads;            // winning worker count
+    uint32_t batch;         // winning batch size (1 where batching is moot)
+    int pin_policy;         // ZION_PIN_* recommendation for that count
+    int full_mem;           // RandomX only: 1 = FULL_MEM dataset, 0 = light
+    double hashrate_hs;     // measured at the winning configuration
+    char config_json[256];  // the same config, ready to persist
+};
+}
+
+namespace zion {
+
+// Thread counts worth measuring on this host, ascending and deduplicated:
+// half the physical cores, the P-cores (hybrid parts), all physical cores,
+// all logical CPUs. Sweeping every count would burn the tuning budget on
+// configurations no sane operator would pick.
+inline std::vector<int> tune_thread_candidates() {
+    zion_topology topo{};
+    Topology::instance().fill(&topo);
+
+    std::vector<int> candidates;
+    auto add = [&](int n) {
+        if (n < 1) return;
+        for (int c : candidates) {
+            if (c == n) return;
+        }
+        candidates.push_back(n);
+    };
+    add(topo.physical_cores / 2);
+    add(topo.p_cores);
+    add(topo.physical_cores);
+    add(topo.logical_cpus);
+    if (candidates.empty()) candidates.push_back(1);
+
+    std::sort(candidates.begin(), candidates.end());
+    return candidates;
+}
+
+// Pinning recommendation for a winning thread count: counts at or below
+// the physical-core count want one worker per core; oversubscribed counts
+// need the full logical set.
+inline int tune_pin_policy(int threads) {
+    zion_topology topo{};
+    Topology::instance().fill(&topo);
+    return (threads <= topo.physical_cores) ? ZION_PIN_PHYSICAL : ZION_PIN_LOGICAL;
+}
+
+} // namespace zion
@@ -9,11 +9,18 @@
  * @date 2025-11-11
  */
 
+#include <chrono>
 #include <cstring>
 #include <cstdint>
 #include <cstdlib>
 #include <cstdio>
 
+#include "zion-big256.h"
+#include "zion-cpu.h"
+#include "zion-topology.h"
+#include "zion-jobslot.h"
+#include "zion-shmring.h"
+
 #ifdef _WIN32
     #define ZION_EXPORT __declspec(dllexport)
 #else
@@ -25,7 +32,22 @@ extern "C" bool randomx_init(const void* key, size_t key_size, int threads);
 extern "C" void zion_randomx_hash_raw(const void* input, size_t input_size, void* output);
 extern "C" void zion_randomx_hash_vm(int vm_index, const void* input, size_t input_size, void* output);
 extern "C" int randomx_get_num_threads();
+extern "C" int randomx_register_thread();
+extern "C" void randomx_unregister_thread();
 extern "C" void randomx_cleanup();
+extern "C" bool randomx_prepare_key(const void* key, size_t key_size);
+extern "C" bool randomx_prepare_ready();
+extern "C" bool randomx_swap_key();
+extern "C" uint32_t zion_randomx_hash_batch_raw(int vm_index, const void* inputs, size_t input_size,
+                                                uint32_t count, void* outputs);
+extern "C" void randomx_set_job_generation(uint64_t generation);
+extern "C" void randomx_set_pin_policy(int policy);
+extern "C" int randomx_get_thread_topology(int* vm_nodes, int max_entries, int* num_nodes);
+struct zion_stats;
+extern "C" int randomx_get_stats(int thread_id, struct zion_stats* out);
+struct zion_tune_result;
+extern "C" int randomx_autotune(int seconds, struct zion_tune_result* out);
+extern "C" int randomx_get_num_stat_slots();
 
 /**
  * Simple C API for Python
@@ -50,6 +72,14 @@ extern "C" ZION_EXPORT int zion_randomx_init(const char* key_hex, int threads) {
     return success ? 1 : 0;
 }
 
+// Initialize from raw key bytes — skips the hex round-trip above, which
+// matters during epoch churn when the orchestrator re-keys frequently
+extern "C" ZION_EXPORT int zion_randomx_init_bytes(const uint8_t* key, size_t key_len, int threads) {
+    if (!key || key_len == 0) return 0;
+    if (threads < 1) threads = 1;
+    return randomx_init(key, key_len, threads) ? 1 : 0;
+}
+
 // Calculate hash from hex string input
 extern "C" ZION_EXPORT void zion_randomx_hash(const char* input_hex, char* output_hex) {
     if (!input_hex || !output_hex) return;
@@ -81,17 +111,126 @@ extern "C" ZION_EXPORT void zion_randomx_hash_bytes(const uint8_t* input, size_t
     zion_randomx_hash_raw(input, input_len, output);
 }
 
+// Calculate a batch of hashes via the pipelined first/next/last API.
+// headers is count contiguous inputs of header_len bytes each; outputs
+// receives count * 32 bytes. Pass vm_index = -1 to use the calling
+// thread's leased VM without locking. Returns the number of hashes
+// completed; less than count means the batch was aborted by
+// zion_set_job_generation().
+extern "C" ZION_EXPORT uint32_t zion_randomx_hash_batch(int vm_index, const uint8_t* headers,
+                                                        size_t header_len, uint32_t count,
+                                                        uint8_t* outputs) {
+    if (!headers || !outputs) return 0;
+    return zion_randomx_hash_batch_raw(vm_index, headers, header_len, count, outputs);
+}
+
+// Bump when the pool pushes new work: in-flight batches abort after the
+// hash currently in the pipeline and return their completed count, so a job
+// switch costs microseconds instead of the rest of the batch
+extern "C" ZION_EXPORT void zion_set_job_generation(uint64_t generation) {
+    randomx_set_job_generation(generation);
+}
+
 // Calculate hash using specific VM (for manual thread control)
 extern "C" ZION_EXPORT void zion_randomx_hash_bytes_vm(int vm_index, const uint8_t* input, size_t input_len, uint8_t* output) {
     if (!input || !output) return;
     zion_randomx_hash_vm(vm_index, input, input_len, output);
 }
 
+/**
+ * Zero-copy job buffers (see zion-jobslot.h)
+ *
+ * Register a persistent header buffer once, mutate it in place from the
+ * caller's side, and hash by slot index — no per-call malloc, parsing, or
+ * copying on the job submission path.
+ */
+
+static zion::JobSlotTable g_job_slots;
+
+// Returns the slot index, or -1 when the table is full
+extern "C" ZION_EXPORT int zion_register_job_buffer(const uint8_t* ptr, size_t len) {
+    return g_job_slots.register_buffer(ptr, len);
+}
+
+// Returns 1 on success, 0 for an empty or bad slot
+extern "C" ZION_EXPORT int zion_unregister_job_buffer(int slot) {
+    return g_job_slots.unregister(slot);
+}
+
+// Hash the first input_len bytes of a registered buffer on the calling
+// thread's leased VM. Returns 1 on success, 0 on a bad slot/length.
+extern "C" ZION_EXPORT int zion_randomx_hash_job(int slot, size_t input_len, uint8_t* output) {
+    const uint8_t* buf = g_job_slots.resolve(slot, input_len);
+    if (!buf || !output) return 0;
+    zion_randomx_hash_raw(buf, input_len, output);
+    return 1;
+}
+
+// Batch variant: the registered buffer holds count contiguous inputs of
+// input_len bytes each (nonces pre-patched in place by the caller).
+// vm_index as in zion_randomx_hash_batch. Returns 1 on success.
+// Returns the number of hashes completed (0 on a bad slot/length); less
+// than count means the batch was aborted by zion_set_job_generation()
+extern "C" ZION_EXPORT uint32_t zion_randomx_hash_job_batch(int slot, int vm_index, size_t input_len,
+                                                            uint32_t count, uint8_t* outputs) {
+    const uint8_t* buf = g_job_slots.resolve(slot, input_len * count);
+    if (!buf || !outputs || count == 0) return 0;
+    return zion_randomx_hash_batch_raw(vm_index, buf, input_len, count, outputs);
+}
+
 // Get number of threads
 extern "C" ZION_EXPORT int zion_randomx_get_num_threads() {
     return randomx_get_num_threads();
 }
 
+// Query VM -> NUMA node assignment (fills vm_nodes, returns VM count).
+// num_nodes receives the detected node count so the orchestrator can pin
+// worker threads next to the dataset copy their VM reads.
+extern "C" ZION_EXPORT int zion_randomx_get_thread_topology(int* vm_nodes, int max_entries,
+                                                            int* num_nodes) {
+    return randomx_get_thread_topology(vm_nodes, max_entries, num_nodes);
+}
+
+// Lease a VM exclusively to the calling thread (lock-free hashing afterwards)
+// Returns the VM index, or -1 on failure
+extern "C" ZION_EXPORT int zion_randomx_register_thread() {
+    return randomx_register_thread();
+}
+
+// Release the calling thread's VM lease
+extern "C" ZION_EXPORT void zion_randomx_unregister_thread() {
+    randomx_unregister_thread();
+}
+
+/**
+ * Cached job-target handle (see ZionTarget in zion-big256.h)
+ *
+ * RandomX target checks run on the caller's side, once per hash — with the
+ * stateless helpers that meant re-parsing the target and redoing the
+ * difficulty division every time. Create the handle once per job instead;
+ * the cached top-64-bit prefix rejects almost every miss with a single
+ * integer compare.
+ */
+extern "C" ZION_EXPORT void* zion_target_create(const uint8_t* target_be) {
+    if (!target_be) return nullptr;
+    return new ZionTarget(ZionTarget::from_be_bytes(target_be));
+}
+
+// Returns 1 when hash <= target (hash in LE limb order, as produced)
+extern "C" ZION_EXPORT int zion_target_check(const void* target, const uint8_t* hash) {
+    if (!target || !hash) return 0;
+    return static_cast<const ZionTarget*>(target)->check(hash) ? 1 : 0;
+}
+
+// 64-bit truncated difficulty, precomputed at create time
+extern "C" ZION_EXPORT uint64_t zion_target_difficulty(const void* target) {
+    return target ? static_cast<const ZionTarget*>(target)->difficulty : 0;
+}
+
+extern "C" ZION_EXPORT void zion_target_destroy(void* target) {
+    delete static_cast<ZionTarget*>(target);
+}
+
 // Check if hash meets difficulty
 extern "C" ZION_EXPORT int zion_randomx_check_difficulty(const uint8_t* hash, int difficulty) {
     if (!hash || difficulty < 1 || difficulty > 32) return 0;
@@ -106,12 +245,139 @@ extern "C" ZION_EXPORT int zion_randomx_check_difficulty(const uint8_t* hash, in
     return zeros >= difficulty ? 1 : 0;
 }
 
+// Start building cache/dataset for a new epoch key in the background
+// (hex key, like zion_randomx_init). Hashing continues on the old key.
+extern "C" ZION_EXPORT int zion_randomx_prepare_key(const char* key_hex) {
+    if (!key_hex) return 0;
+    
+    size_t key_len = strlen(key_hex) / 2;
+    uint8_t* key_bytes = (uint8_t*)malloc(key_len);
+    
+    for (size_t i = 0; i < key_len; i++) {
+        sscanf(key_hex + 2*i, "%2hhx", &key_bytes[i]);
+    }
+    
+    bool success = randomx_prepare_key(key_bytes, key_len);
+    free(key_bytes);
+    
+    return success ? 1 : 0;
+}
+
+// Returns 1 once the prepared key is ready to swap in
+extern "C" ZION_EXPORT int zion_randomx_prepare_ready() {
+    return randomx_prepare_ready() ? 1 : 0;
+}
+
+// Repoint the VM pool at the prepared key (milliseconds, no hashing gap)
+extern "C" ZION_EXPORT int zion_randomx_swap_key() {
+    return randomx_swap_key() ? 1 : 0;
+}
+
 // Cleanup
 extern "C" ZION_EXPORT void zion_randomx_cleanup() {
     randomx_cleanup();
 }
 
 // Get version
+// Core topology snapshot (physical cores, SMT ratio, P/E split, NUMA
+// nodes — see zion-topology.h). Returns 1 on success.
+extern "C" ZION_EXPORT int zion_topology_query(struct zion_topology* out) {
+    if (!out) return 0;
+    zion::Topology::instance().fill(out);
+    return 1;
+}
+
+// Pin the calling thread to the worker_id-th CPU of the policy's set
+// (ZION_PIN_PHYSICAL / ZION_PIN_PCORE / ZION_PIN_LOGICAL). Returns 1 when
+// the affinity change succeeded.
+extern "C" ZION_EXPORT int zion_pin_thread(int worker_id, int policy) {
+    return zion::Topology::instance().pin_current(worker_id, policy) ? 1 : 0;
+}
+
+// Pinning policy applied when worker threads claim their VM slot; call
+// before workers register (or set ZION_PIN_POLICY in the environment)
+extern "C" ZION_EXPORT void zion_randomx_set_pin_policy(int policy) {
+    randomx_set_pin_policy(policy);
+}
+
+/**
+ * Shared-memory share ring (see zion-shmring.h)
+ *
+ * RandomX has no in-library target check, so share detection stays with the
+ * hashing thread — zion_ring_push() lets that thread hand the share to the
+ * orchestrator through the mapped ring instead of a ctypes callback. One
+ * ring per producer thread; the consumer drains all rings in one call.
+ */
+
+static zion::ShmRing g_share_ring;
+
+// Returns 1 on success. num_rings should match the worker thread count.
+extern "C" ZION_EXPORT int zion_ring_create(const char* path, uint32_t num_rings,
+                                            uint32_t capacity) {
+    return g_share_ring.create(path, num_rings, capacity) ? 1 : 0;
+}
+
+// Map a ring file created elsewhere (consumer side). Returns 1 on success.
+extern "C" ZION_EXPORT int zion_ring_attach(const char* path) {
+    return g_share_ring.attach(path) ? 1 : 0;
+}
+
+// Producer side: append one share from ring_index's owning thread.
+// Returns 1 on success, 0 when the ring is full (the share is dropped and
+// counted; resubmit from the caller if it matters).
+extern "C" ZION_EXPORT int zion_ring_push(uint32_t ring_index, uint64_t job_id, uint32_t nonce,
+                                          uint32_t thread_id, const uint8_t* hash) {
+    if (!hash) return 0;
+    zion_share_record rec;
+    rec.job_id = job_id;
+    rec.timestamp_us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    rec.nonce = nonce;
+    rec.thread_id = thread_id;
+    memcpy(rec.hash, hash, 32);
+    return g_share_ring.push(ring_index, rec) ? 1 : 0;
+}
+
+// Drain up to max records across all rings. Single consumer only.
+extern "C" ZION_EXPORT uint32_t zion_ring_drain(struct zion_share_record* out, uint32_t max) {
+    return g_share_ring.drain(out, max);
+}
+
+// Records lost to full rings (stalled consumer) since creation
+extern "C" ZION_EXPORT uint64_t zion_ring_drops() {
+    return g_share_ring.total_drops();
+}
+
+extern "C" ZION_EXPORT void zion_ring_close() {
+    g_share_ring.close();
+}
+
+// First-run auto-tune: sweep thread counts against measured H/s, flag
+// FULL_MEM memory pressure, emit the winning config (see zion-tune.h)
+extern "C" ZION_EXPORT int zion_autotune(int seconds, struct zion_tune_result* out) {
+    return randomx_autotune(seconds, out);
+}
+
+// Detected CPU feature bitmask / readable form (see zion-cpu.h)
+extern "C" ZION_EXPORT uint64_t zion_cpu_features() {
+    return zion::cpu_features();
+}
+
+extern "C" ZION_EXPORT const char* zion_cpu_features_string() {
+    return zion::cpu_features_string();
+}
+
+// Snapshot one worker thread's counters (see zion-stats.h; stage 0 is the
+// full VM hash). Returns 0 for an out-of-range thread_id.
+extern "C" ZION_EXPORT int zion_randomx_get_stats(int thread_id, struct zion_stats* out) {
+    return randomx_get_stats(thread_id, out);
+}
+
+// Number of stats slots handed out so far (= threads that have hashed)
+extern "C" ZION_EXPORT int zion_randomx_get_num_stat_slots() {
+    return randomx_get_num_stat_slots();
+}
+
 extern "C" ZION_EXPORT const char* zion_randomx_version() {
     return "ZION RandomX 2.9.0 (Multi-threaded)";
 }
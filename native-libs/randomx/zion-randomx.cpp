@@ -23,6 +23,9 @@
  */
 
 #include <randomx.h>
+#include "zion-stats.h"
+#include "zion-topology.h"
+#include "zion-tune.h"
 #include <cstring>
 #include <cstdint>
 #include <cstdlib>
@@ -33,6 +36,18 @@
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 static int clamp_int(int v, int lo, int hi) {
     if (v < lo) return lo;
@@ -47,10 +62,161 @@ static std::vector<uint8_t> current_key;
 static std::mutex init_mutex;
 
 // Thread pool: one VM per thread for parallel mining
-static std::vector<randomx_vm*> vm_pool;
+// Each slot can be leased exclusively to one worker thread via
+// randomx_register_thread(), making the per-hash path completely lock-free.
+struct VmSlot {
+    randomx_vm* vm = nullptr;
+    std::atomic<bool> leased{false};
+};
+static std::vector<VmSlot*> vm_pool;
 static std::vector<std::mutex*> vm_mutexes;
 static int num_threads = 1;
 
+// Hard ceiling on pool size. The vectors are reserved to it at init so
+// overflow growth never reallocates: lock-free readers (the registration
+// scans, the vm_index checks in the hash paths) go through vm_pool_count,
+// published with a release store after each append, and would hit a
+// reallocating vector mid-scan otherwise.
+static const size_t ZION_RANDOMX_MAX_VMS = 256;
+static std::atomic<size_t> vm_pool_count{0};
+
+// Flags the pool was actually created with (after large-pages/FULL_MEM
+// fallbacks), so overflow VMs created later match the existing ones.
+static randomx_flags pool_vm_flags = RANDOMX_FLAG_DEFAULT;
+static bool pool_have_dataset = false;
+
+// Bumped on every init/cleanup so stale thread-local leases from a previous
+// pool generation are dropped instead of dereferencing freed VMs.
+static std::atomic<uint64_t> pool_generation{0};
+
+// Per-thread lease state
+static thread_local VmSlot* tls_vm_slot = nullptr;
+static thread_local uint64_t tls_vm_generation = 0;
+
+// Worker pinning policy (ZION_PIN_* from zion-topology.h), applied when a
+// thread claims its VM slot. ZION_PIN_PHYSICAL is usually right here: two
+// SMT siblings sharing one core's scratchpad bandwidth hash slower than one
+// pinned thread. Settable via randomx_set_pin_policy() or ZION_PIN_POLICY.
+static std::atomic<int> g_pin_policy{-1};  // -1 = read env on first use
+
+static int pin_policy() {
+    int policy = g_pin_policy.load(std::memory_order_relaxed);
+    if (policy < 0) {
+        const char* env = std::getenv("ZION_PIN_POLICY");
+        policy = (env && env[0]) ? atoi(env) : ZION_PIN_NONE;
+        g_pin_policy.store(policy, std::memory_order_relaxed);
+    }
+    return policy;
+}
+
+extern "C" void randomx_set_pin_policy(int policy) {
+    g_pin_policy.store(policy, std::memory_order_relaxed);
+}
+
+// NUMA replication (opt-in via ZION_RANDOMX_NUMA=1 on multi-socket boxes):
+// one dataset copy per node, initialized by threads pinned to that node so
+// first-touch places the pages locally, with VMs assigned round-robin and
+// the assignment exposed through randomx_get_thread_topology().
+static std::vector<std::vector<int>> numa_node_cpus;   // CPUs per node
+static std::vector<randomx_dataset*> numa_datasets;    // replicas for nodes 1..N-1
+static std::vector<int> vm_node_assignment;            // node index per VM
+static bool numa_replication_active = false;
+
+/**
+ * Enumerate NUMA nodes and their CPUs from sysfs (Linux only)
+ * Returns one CPU list per node; a single entry means no NUMA topology.
+ */
+static std::vector<std::vector<int>> detect_numa_nodes() {
+    std::vector<std::vector<int>> nodes;
+#ifdef __linux__
+    for (int node = 0; node < 64; node++) {
+        std::ifstream f("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!f.good()) break;
+        
+        std::string cpulist;
+        std::getline(f, cpulist);
+        
+        // Parse "0-7,16-23" style ranges
+        std::vector<int> cpus;
+        std::stringstream ss(cpulist);
+        std::string part;
+        while (std::getline(ss, part, ',')) {
+            size_t dash = part.find('-');
+            if (dash == std::string::npos) {
+                if (!part.empty()) cpus.push_back(std::stoi(part));
+            } else {
+                int lo = std::stoi(part.substr(0, dash));
+                int hi = std::stoi(part.substr(dash + 1));
+                for (int c = lo; c <= hi; c++) cpus.push_back(c);
+            }
+        }
+        if (!cpus.empty()) nodes.push_back(std::move(cpus));
+    }
+#endif
+    if (nodes.empty()) {
+        // No sysfs topology (or non-Linux): treat the machine as one node
+        std::vector<int> all;
+        int hw = (int)std::thread::hardware_concurrency();
+        for (int c = 0; c < hw; c++) all.push_back(c);
+        nodes.push_back(std::move(all));
+    }
+    return nodes;
+}
+
+/**
+ * Pin the calling thread to a CPU set (best-effort, Linux only)
+ */
+static void pin_current_thread_to_cpus(const std::vector<int>& cpus) {
+#ifdef __linux__
+    if (cpus.empty()) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c : cpus) CPU_SET(c, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpus;
+#endif
+}
+
+/**
+ * Initialize a dataset with threads pinned to one NUMA node's CPUs
+ * so first-touch allocation places the 2GB of pages on that node.
+ */
+static void init_dataset_on_node(randomx_dataset* dataset, randomx_cache* cache,
+                                 const std::vector<int>& node_cpus) {
+    const uint64_t total_items = randomx_dataset_item_count();
+    int init_threads = clamp_int((int)node_cpus.size(), 1, 32);
+    
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(init_threads));
+    
+    const uint64_t chunk = (total_items + static_cast<uint64_t>(init_threads) - 1) / static_cast<uint64_t>(init_threads);
+    for (int t = 0; t < init_threads; t++) {
+        const uint64_t start_item = static_cast<uint64_t>(t) * chunk;
+        if (start_item >= total_items) break;
+        const uint64_t count = std::min<uint64_t>(chunk, total_items - start_item);
+        workers.emplace_back([dataset, cache, start_item, count, &node_cpus]() {
+            pin_current_thread_to_cpus(node_cpus);
+            randomx_init_dataset(dataset, cache, start_item, count);
+        });
+    }
+    
+    for (auto& w : workers) {
+        if (w.joinable()) w.join();
+    }
+}
+
+// Double-buffered key switch: the next epoch's cache/dataset are built on a
+// background thread by randomx_prepare_key() while the current pool keeps
+// hashing, then randomx_swap_key() repoints the VMs in milliseconds.
+static randomx_cache* pending_cache = nullptr;
+static randomx_dataset* pending_dataset = nullptr;
+static std::vector<uint8_t> pending_key;
+static randomx_flags pending_flags = RANDOMX_FLAG_DEFAULT;
+static std::atomic<bool> pending_ready{false};
+static std::atomic<bool> pending_in_progress{false};
+static std::thread prepare_thread;
+
 // Flags for optimal performance
 static randomx_flags get_optimal_flags() {
     randomx_flags flags = randomx_get_flags();
@@ -76,6 +242,179 @@ static randomx_flags get_optimal_flags() {
     return flags;
 }
 
+/**
+ * Initialize a dataset from a cache across multiple threads
+ * Shared by randomx_init() and the background key-switch path
+ */
+static void init_dataset_multithreaded(randomx_dataset* dataset, randomx_cache* cache,
+                                       int init_threads) {
+    const uint64_t total_items = randomx_dataset_item_count();
+    init_threads = clamp_int(init_threads, 1, 32);
+
+    if (init_threads <= 1) {
+        randomx_init_dataset(dataset, cache, 0, total_items);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(init_threads));
+
+    const uint64_t chunk = (total_items + static_cast<uint64_t>(init_threads) - 1) / static_cast<uint64_t>(init_threads);
+    for (int t = 0; t < init_threads; t++) {
+        const uint64_t start_item = static_cast<uint64_t>(t) * chunk;
+        if (start_item >= total_items) break;
+        const uint64_t count = std::min<uint64_t>(chunk, total_items - start_item);
+        workers.emplace_back([dataset, cache, start_item, count]() {
+            randomx_init_dataset(dataset, cache, start_item, count);
+        });
+    }
+
+    for (auto& w : workers) {
+        if (w.joinable()) w.join();
+    }
+}
+
+/**
+ * Persistent dataset cache
+ *
+ * The dataset is a pure function of the key, so after the first build we
+ * write it to a key-addressed file and warm restarts map it back instead of
+ * repeating the 10-60 second Argon2/SuperscalarHash recomputation. The file
+ * starts with a header carrying the full key, so a (theoretical) filename
+ * hash collision degrades to a cache miss, never a wrong dataset.
+ *
+ * Directory: ZION_RANDOMX_CACHE_DIR (default /var/cache/zion); disable with
+ * ZION_RANDOMX_DATASET_CACHE=0. Any I/O failure just falls back to the
+ * normal build path with a warning.
+ */
+
+struct DatasetCacheHeader {
+    char magic[4];          // "ZRXD"
+    uint32_t version;       // 1
+    uint32_t key_len;
+    uint32_t reserved;
+    uint64_t dataset_bytes;
+};
+
+static bool dataset_cache_enabled() {
+    const char* env = std::getenv("ZION_RANDOMX_DATASET_CACHE");
+    return !(env && env[0] == '0');
+}
+
+static std::string dataset_cache_path(const uint8_t* key, size_t key_size) {
+    const char* dir = std::getenv("ZION_RANDOMX_CACHE_DIR");
+    if (!dir || !dir[0]) dir = "/var/cache/zion";
+    
+    // FNV-1a 64 over the key names the file; the header verifies the key
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < key_size; i++) {
+        h = (h ^ key[i]) * 0x100000001b3ull;
+    }
+    
+    char name[64];
+    snprintf(name, sizeof(name), "/rx-%016llx.dat", (unsigned long long)h);
+    return std::string(dir) + name;
+}
+
+/**
+ * Fill an allocated dataset from the cache file, if one exists for this key
+ * The file is mapped with MAP_POPULATE so the kernel streams it in
+ * sequentially (NVMe-speed) rather than demand-faulting 4KB at a time.
+ */
+static bool try_load_dataset_cache(randomx_dataset* dataset, const uint8_t* key, size_t key_size) {
+#ifdef __linux__
+    if (!dataset_cache_enabled()) return false;
+    
+    const std::string path = dataset_cache_path(key, key_size);
+    const uint64_t dataset_bytes = randomx_dataset_item_count() * 64ull;
+    
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;  // plain cache miss, no warning
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        (uint64_t)st.st_size != sizeof(DatasetCacheHeader) + key_size + dataset_bytes) {
+        std::cout << "⚠️  Dataset cache " << path << " has wrong size, ignoring" << std::endl;
+        close(fd);
+        return false;
+    }
+    
+    void* map = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        std::cout << "⚠️  Dataset cache mmap failed, rebuilding" << std::endl;
+        return false;
+    }
+    
+    const DatasetCacheHeader* hdr = static_cast<const DatasetCacheHeader*>(map);
+    const uint8_t* stored_key = static_cast<const uint8_t*>(map) + sizeof(DatasetCacheHeader);
+    bool valid = memcmp(hdr->magic, "ZRXD", 4) == 0 && hdr->version == 1
+                 && hdr->key_len == key_size && hdr->dataset_bytes == dataset_bytes
+                 && memcmp(stored_key, key, key_size) == 0;
+    
+    if (valid) {
+        memcpy(randomx_get_dataset_memory(dataset), stored_key + key_size, dataset_bytes);
+    } else {
+        std::cout << "⚠️  Dataset cache " << path << " failed validation, rebuilding" << std::endl;
+    }
+    
+    munmap(map, (size_t)st.st_size);
+    return valid;
+#else
+    // No mmap/rename plumbing off Linux; warm restarts rebuild the dataset
+    (void)dataset; (void)key; (void)key_size;
+    return false;
+#endif
+}
+
+/**
+ * Persist a freshly built dataset for the next restart
+ * Written to a temp file and renamed so readers never see a partial file.
+ */
+static void save_dataset_cache(randomx_dataset* dataset, const uint8_t* key, size_t key_size) {
+#ifdef __linux__
+    if (!dataset_cache_enabled()) return;
+    
+    const std::string path = dataset_cache_path(key, key_size);
+    const std::string tmp = path + ".tmp." + std::to_string((long)getpid());
+    const uint64_t dataset_bytes = randomx_dataset_item_count() * 64ull;
+    
+    int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cout << "⚠️  Dataset cache not writable (" << path << "), skipping" << std::endl;
+        return;
+    }
+    
+    DatasetCacheHeader hdr;
+    memcpy(hdr.magic, "ZRXD", 4);
+    hdr.version = 1;
+    hdr.key_len = (uint32_t)key_size;
+    hdr.reserved = 0;
+    hdr.dataset_bytes = dataset_bytes;
+    
+    bool ok = write(fd, &hdr, sizeof(hdr)) == (ssize_t)sizeof(hdr)
+              && write(fd, key, key_size) == (ssize_t)key_size;
+    
+    // Dataset body in bounded chunks (a single 2GB write can fail on some kernels)
+    const uint8_t* data = static_cast<const uint8_t*>(randomx_get_dataset_memory(dataset));
+    for (uint64_t off = 0; ok && off < dataset_bytes; ) {
+        size_t chunk = (size_t)std::min<uint64_t>(dataset_bytes - off, 64ull << 20);
+        ok = write(fd, data + off, chunk) == (ssize_t)chunk;
+        off += chunk;
+    }
+    close(fd);
+    
+    if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+        std::cout << "⚠️  Dataset cache write failed, removing partial file" << std::endl;
+        unlink(tmp.c_str());
+        return;
+    }
+    std::cout << "✅ Dataset cached to " << path << std::endl;
+#else
+    (void)dataset; (void)key; (void)key_size;
+#endif
+}
+
 /**
  * Initialize RandomX with a specific key and thread count
  * This creates the cache, dataset (2+ GB), and VM pool
@@ -119,9 +458,14 @@ extern "C" bool randomx_init(const void* key, size_t key_size, int threads) {
         std::cout << "  FULL_MEM: " << ((flags & RANDOMX_FLAG_FULL_MEM) ? "YES (fast mode)" : "NO (slow mode)") << std::endl;
         std::cout << "  LARGE_PAGES: " << ((flags & RANDOMX_FLAG_LARGE_PAGES) ? "enabled (30-40% boost!)" : "disabled") << std::endl;
         
-        // Destroy existing VM pool
-        for (auto vm : vm_pool) {
-            if (vm) randomx_destroy_vm(vm);
+        // Destroy existing VM pool (invalidate outstanding thread leases first)
+        pool_generation.fetch_add(1);
+        vm_pool_count.store(0, std::memory_order_release);
+        for (auto slot : vm_pool) {
+            if (slot) {
+                if (slot->vm) randomx_destroy_vm(slot->vm);
+                delete slot;
+            }
         }
         vm_pool.clear();
         
@@ -130,7 +474,13 @@ extern "C" bool randomx_init(const void* key, size_t key_size, int threads) {
         }
         vm_mutexes.clear();
         
-        // Destroy existing dataset and cache
+        // Destroy existing dataset and cache (including NUMA replicas)
+        for (auto replica : numa_datasets) {
+            if (replica) randomx_release_dataset(replica);
+        }
+        numa_datasets.clear();
+        vm_node_assignment.clear();
+        numa_replication_active = false;
         if (global_dataset) {
             randomx_release_dataset(global_dataset);
             global_dataset = nullptr;
@@ -177,36 +527,45 @@ extern "C" bool randomx_init(const void* key, size_t key_size, int threads) {
                 std::cout << "⏳ Initializing RandomX dataset (10-60 seconds)..." << std::endl;
                 auto start = std::chrono::high_resolution_clock::now();
 
-                const uint64_t total_items = randomx_dataset_item_count();
                 int init_threads = std::thread::hardware_concurrency();
-                init_threads = clamp_int(init_threads, 1, 32);
                 if (init_threads > num_threads) {
                     // Use at most the requested mining threads to avoid over-saturating.
                     init_threads = num_threads;
-                    init_threads = clamp_int(init_threads, 1, 32);
                 }
 
                 std::cout << "⏳ Dataset init threads: " << init_threads << std::endl;
 
-                if (init_threads <= 1) {
-                    randomx_init_dataset(global_dataset, global_cache, 0, total_items);
-                } else {
-                    std::vector<std::thread> workers;
-                    workers.reserve(static_cast<size_t>(init_threads));
-
-                    const uint64_t chunk = (total_items + static_cast<uint64_t>(init_threads) - 1) / static_cast<uint64_t>(init_threads);
-                    for (int t = 0; t < init_threads; t++) {
-                        const uint64_t start_item = static_cast<uint64_t>(t) * chunk;
-                        if (start_item >= total_items) break;
-                        const uint64_t count = std::min<uint64_t>(chunk, total_items - start_item);
-                        workers.emplace_back([start_item, count]() {
-                            randomx_init_dataset(global_dataset, global_cache, start_item, count);
-                        });
-                    }
+                // Optional NUMA replication: one dataset per node so no VM
+                // reads the 2GB table across the socket interconnect.
+                const char* numa_env = std::getenv("ZION_RANDOMX_NUMA");
+                numa_node_cpus = detect_numa_nodes();
+                numa_replication_active = (numa_env && numa_env[0] && numa_env[0] != '0')
+                                          && numa_node_cpus.size() > 1;
 
-                    for (auto& w : workers) {
-                        if (w.joinable()) w.join();
+                if (numa_replication_active) {
+                    std::cout << "⏳ NUMA replication: " << numa_node_cpus.size()
+                              << " nodes, one dataset copy each" << std::endl;
+                    // Node 0 gets global_dataset, initialized by node-0-pinned
+                    // threads so first-touch places its pages locally
+                    init_dataset_on_node(global_dataset, global_cache, numa_node_cpus[0]);
+                    
+                    for (size_t node = 1; node < numa_node_cpus.size(); node++) {
+                        randomx_dataset* replica = randomx_alloc_dataset(working_flags);
+                        if (!replica) {
+                            std::cout << "⚠️  Dataset replica for node " << node
+                                      << " failed to allocate; node shares node 0's copy" << std::endl;
+                            numa_datasets.push_back(nullptr);
+                            continue;
+                        }
+                        init_dataset_on_node(replica, global_cache, numa_node_cpus[node]);
+                        numa_datasets.push_back(replica);
                     }
+                } else if (try_load_dataset_cache(global_dataset,
+                                                  current_key.data(), current_key.size())) {
+                    std::cout << "✅ Dataset restored from cache (skipped recomputation)" << std::endl;
+                } else {
+                    init_dataset_multithreaded(global_dataset, global_cache, init_threads);
+                    save_dataset_cache(global_dataset, current_key.data(), current_key.size());
                 }
                 auto end = std::chrono::high_resolution_clock::now();
                 auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
@@ -224,8 +583,25 @@ extern "C" bool randomx_init(const void* key, size_t key_size, int threads) {
         randomx_flags vm_flags = working_flags;
         bool large_pages_failed = false;
         
+        // Reserve the ceiling up front; see vm_pool_count
+        vm_pool.reserve(ZION_RANDOMX_MAX_VMS);
+        vm_mutexes.reserve(ZION_RANDOMX_MAX_VMS);
+        vm_node_assignment.reserve(ZION_RANDOMX_MAX_VMS);
+        
         for (int i = 0; i < num_threads; i++) {
-            randomx_vm* vm = randomx_create_vm(vm_flags, global_cache, have_dataset ? global_dataset : nullptr);
+            // Round-robin VMs across NUMA nodes; each VM reads its local copy
+            int node = 0;
+            randomx_dataset* vm_dataset = global_dataset;
+            if (numa_replication_active && have_dataset) {
+                node = i % (int)numa_node_cpus.size();
+                if (node > 0 && numa_datasets[node - 1]) {
+                    vm_dataset = numa_datasets[node - 1];
+                } else {
+                    node = (node > 0 && !numa_datasets[node - 1]) ? 0 : node;
+                }
+            }
+            
+            randomx_vm* vm = randomx_create_vm(vm_flags, global_cache, have_dataset ? vm_dataset : nullptr);
             
             if (!vm && (vm_flags & RANDOMX_FLAG_LARGE_PAGES)) {
                 // Retry without large pages on first failure
@@ -233,24 +609,36 @@ extern "C" bool randomx_init(const void* key, size_t key_size, int threads) {
                     std::cout << "⚠️  Large pages unavailable, falling back to small pages" << std::endl;
                     vm_flags = static_cast<randomx_flags>(vm_flags & ~RANDOMX_FLAG_LARGE_PAGES);
                     large_pages_failed = true;
-                    vm = randomx_create_vm(vm_flags, global_cache, have_dataset ? global_dataset : nullptr);
+                    vm = randomx_create_vm(vm_flags, global_cache, have_dataset ? vm_dataset : nullptr);
                 }
             }
             
             if (!vm) {
                 std::cerr << "❌ Failed to create VM #" << i << std::endl;
                 // Cleanup already created VMs
-                for (auto v : vm_pool) {
-                    if (v) randomx_destroy_vm(v);
+                vm_pool_count.store(0, std::memory_order_release);
+                for (auto slot : vm_pool) {
+                    if (slot) {
+                        if (slot->vm) randomx_destroy_vm(slot->vm);
+                        delete slot;
+                    }
                 }
                 vm_pool.clear();
                 return false;
             }
             
-            vm_pool.push_back(vm);
+            VmSlot* slot = new VmSlot();
+            slot->vm = vm;
+            vm_pool.push_back(slot);
             vm_mutexes.push_back(new std::mutex());
+            vm_node_assignment.push_back(node);
         }
         
+        // Remember effective settings so overflow VMs match this pool
+        pool_vm_flags = vm_flags;
+        pool_have_dataset = have_dataset;
+        vm_pool_count.store(vm_pool.size(), std::memory_order_release);
+        
         std::cout << "✅ Created " << vm_pool.size() << " RandomX VMs successfully!" << std::endl;
 
         // Avoid misleading fixed estimates: do a tiny in-process sample to approximate H/s.
@@ -262,7 +650,7 @@ extern "C" bool randomx_init(const void* key, size_t key_size, int threads) {
             auto t0 = std::chrono::high_resolution_clock::now();
             for (int i = 0; i < samples; i++) {
                 input[38] = (uint8_t)i;
-                randomx_calculate_hash(vm_pool[0], input, sizeof(input), out);
+                randomx_calculate_hash(vm_pool[0]->vm, input, sizeof(input), out);
             }
             auto t1 = std::chrono::high_resolution_clock::now();
             std::chrono::duration<double> dt = t1 - t0;
@@ -281,35 +669,130 @@ extern "C" bool randomx_init(const void* key, size_t key_size, int threads) {
 }
 
 /**
- * Calculate RandomX hash using thread pool
- * Automatically selects next available VM from pool
+ * Lease a VM exclusively to the calling thread
+ * 
+ * Scans the pool for an unleased slot and claims it with a single CAS.
+ * If every VM is leased (more worker threads than VMs, e.g. after a
+ * reconfigure), the pool is grown under init_mutex instead of making
+ * threads contend on shared VMs.
+ * 
+ * @return VM index on success, -1 if not initialized or growth failed
+ */
+extern "C" int randomx_register_thread() {
+    const size_t pool_size = vm_pool_count.load(std::memory_order_acquire);
+    if (tls_vm_slot && tls_vm_generation == pool_generation.load()) {
+        // Already registered in this pool generation
+        for (size_t i = 0; i < pool_size; i++) {
+            if (vm_pool[i] == tls_vm_slot) return (int)i;
+        }
+    }
+    tls_vm_slot = nullptr;
+    
+    if (pool_size == 0) {
+        std::cerr << "❌ RandomX not initialized! Call randomx_init() first" << std::endl;
+        return -1;
+    }
+    
+    // Claim a free slot lock-free
+    for (size_t i = 0; i < pool_size; i++) {
+        bool expected = false;
+        if (vm_pool[i]->leased.compare_exchange_strong(expected, true)) {
+            tls_vm_slot = vm_pool[i];
+            tls_vm_generation = pool_generation.load();
+            zion::Topology::instance().pin_current((int)i, pin_policy());
+            return (int)i;
+        }
+    }
+    
+    // All VMs leased: grow the pool instead of contending
+    std::lock_guard<std::mutex> lock(init_mutex);
+    if (vm_pool.size() >= ZION_RANDOMX_MAX_VMS) {
+        std::cerr << "❌ RandomX VM pool at its " << ZION_RANDOMX_MAX_VMS
+                  << "-VM ceiling; refusing to grow" << std::endl;
+        return -1;
+    }
+    randomx_vm* vm = randomx_create_vm(pool_vm_flags, global_cache,
+                                       pool_have_dataset ? global_dataset : nullptr);
+    if (!vm) {
+        std::cerr << "❌ Failed to grow RandomX VM pool for new worker thread" << std::endl;
+        return -1;
+    }
+    
+    VmSlot* slot = new VmSlot();
+    slot->vm = vm;
+    slot->leased.store(true);
+    vm_pool.push_back(slot);
+    vm_mutexes.push_back(new std::mutex());
+    vm_node_assignment.push_back(0);
+    vm_pool_count.store(vm_pool.size(), std::memory_order_release);
+    
+    std::cout << "⚠️  RandomX VM pool grown to " << vm_pool.size()
+              << " VMs (more worker threads than configured)" << std::endl;
+    
+    tls_vm_slot = slot;
+    tls_vm_generation = pool_generation.load();
+    zion::Topology::instance().pin_current((int)vm_pool.size() - 1, pin_policy());
+    return (int)vm_pool.size() - 1;
+}
+
+/**
+ * Release the calling thread's VM lease back to the pool
+ */
+extern "C" void randomx_unregister_thread() {
+    if (tls_vm_slot && tls_vm_generation == pool_generation.load()) {
+        tls_vm_slot->leased.store(false);
+    }
+    tls_vm_slot = nullptr;
+}
+
+/**
+ * Calculate RandomX hash using the calling thread's leased VM
+ * Registers the thread on first use; the steady-state path is lock-free
  * 
  * @param input Input data to hash
  * @param input_size Size of input data
  * @param output Output buffer (must be 32 bytes)
  */
+// Job generation counter: the orchestrator bumps it on new work and any
+// in-flight batch aborts after the hash it is currently pipelining.
+static std::atomic<uint64_t> g_job_generation{0};
+
+extern "C" void randomx_set_job_generation(uint64_t generation) {
+    g_job_generation.store(generation, std::memory_order_relaxed);
+}
+
+// Per-thread hashrate counters (stage 0 = full VM hash; see zion-stats.h).
+// A VM hash runs for hundreds of microseconds, so timing every call is in
+// the noise -- no sampling needed here.
+static zion::StatsRegistry g_stats;
+
+extern "C" int randomx_get_stats(int thread_id, zion_stats* out) {
+    return g_stats.read(thread_id, out);
+}
+
+extern "C" int randomx_get_num_stat_slots() {
+    return g_stats.num_slots();
+}
+
 extern "C" void zion_randomx_hash_raw(const void* input, size_t input_size, void* output) {
-    if (vm_pool.empty()) {
-        std::cerr << "❌ RandomX not initialized! Call randomx_init() first" << std::endl;
-        memset(output, 0, 32);
-        return;
+    // Drop leases that outlived their pool (re-init since registration)
+    if (tls_vm_slot && tls_vm_generation != pool_generation.load()) {
+        tls_vm_slot = nullptr;
     }
     
-    // Simple round-robin: use first available VM
-    // For production, could use thread-local storage or better load balancing
-    static thread_local int thread_vm_index = -1;
-    
-    if (thread_vm_index < 0 || thread_vm_index >= (int)vm_pool.size()) {
-        // Assign VM to this thread (simple round-robin)
-        static std::atomic<int> next_vm_index{0};
-        thread_vm_index = next_vm_index.fetch_add(1) % vm_pool.size();
+    if (!tls_vm_slot) {
+        if (randomx_register_thread() < 0) {
+            memset(output, 0, 32);
+            return;
+        }
     }
     
-    // Lock this VM for hashing
-    std::lock_guard<std::mutex> lock(*vm_mutexes[thread_vm_index]);
-    
-    // Calculate hash
-    randomx_calculate_hash(vm_pool[thread_vm_index], input, input_size, output);
+    // Exclusive ownership: no lock needed
+    zion::ThreadStats& stats = g_stats.slot_for_thread();
+    double t0 = zion::StatsRegistry::now_us();
+    randomx_calculate_hash(tls_vm_slot->vm, input, input_size, output);
+    zion::StatsRegistry::record_stage(stats, 0, zion::StatsRegistry::now_us() - t0);
+    stats.hashes.fetch_add(1, std::memory_order_relaxed);
 }
 
 /**
@@ -322,21 +805,373 @@ extern "C" void zion_randomx_hash_raw(const void* input, size_t input_size, void
  * @param output Output buffer (must be 32 bytes)
  */
 extern "C" void zion_randomx_hash_vm(int vm_index, const void* input, size_t input_size, void* output) {
-    if (vm_index < 0 || vm_index >= (int)vm_pool.size()) {
+    if (vm_index < 0 || vm_index >= (int)vm_pool_count.load(std::memory_order_acquire)) {
         std::cerr << "❌ Invalid VM index: " << vm_index << std::endl;
         memset(output, 0, 32);
         return;
     }
     
     std::lock_guard<std::mutex> lock(*vm_mutexes[vm_index]);
-    randomx_calculate_hash(vm_pool[vm_index], input, input_size, output);
+    randomx_calculate_hash(vm_pool[vm_index]->vm, input, input_size, output);
+}
+
+/**
+ * Calculate a batch of hashes on one VM using the pipelined API
+ * 
+ * randomx_calculate_hash_first/next/last overlap the final Blake2b of
+ * hash N with the scratchpad initialization of hash N+1, worth a few
+ * percent over one-shot randomx_calculate_hash on top of amortizing the
+ * FFI crossing across the whole batch.
+ * 
+ * @param vm_index VM index (0 to pool size-1), or -1 for the calling
+ *                 thread's leased VM (registers on first use)
+ * @param inputs Contiguous array of count inputs, each input_size bytes
+ * @param input_size Size of each input
+ * @param count Number of inputs
+ * @param outputs Output buffer (count * 32 bytes)
+ */
+extern "C" uint32_t zion_randomx_hash_batch_raw(int vm_index, const void* inputs, size_t input_size,
+                                                uint32_t count, void* outputs) {
+    if (count == 0) return 0;
+    
+    const uint8_t* in = static_cast<const uint8_t*>(inputs);
+    uint8_t* out = static_cast<uint8_t*>(outputs);
+    
+    randomx_vm* vm = nullptr;
+    std::mutex* vm_lock = nullptr;
+    
+    if (vm_index < 0) {
+        // Use (or establish) this thread's exclusive lease - lock-free
+        if (tls_vm_slot && tls_vm_generation != pool_generation.load()) {
+            tls_vm_slot = nullptr;
+        }
+        if (!tls_vm_slot && randomx_register_thread() < 0) {
+            memset(outputs, 0, (size_t)count * 32);
+            return 0;
+        }
+        vm = tls_vm_slot->vm;
+    } else {
+        if (vm_index >= (int)vm_pool_count.load(std::memory_order_acquire)) {
+            std::cerr << "❌ Invalid VM index: " << vm_index << std::endl;
+            memset(outputs, 0, (size_t)count * 32);
+            return 0;
+        }
+        vm = vm_pool[vm_index]->vm;
+        vm_lock = vm_mutexes[vm_index];
+    }
+    
+    if (vm_lock) vm_lock->lock();
+    
+    zion::ThreadStats& stats = g_stats.slot_for_thread();
+    double t0 = zion::StatsRegistry::now_us();
+    
+    // Poll the job generation between hashes (one VM hash is hundreds of
+    // microseconds, so per-iteration polling is free). On a bump, flush the
+    // hash already in the pipeline and return the completed count — callers
+    // stop wasting milliseconds of stale work per job switch.
+    const uint64_t entry_gen = g_job_generation.load(std::memory_order_relaxed);
+    uint32_t completed = count;
+    
+    randomx_calculate_hash_first(vm, in, input_size);
+    for (uint32_t i = 1; i < count; i++) {
+        if (g_job_generation.load(std::memory_order_relaxed) != entry_gen) {
+            randomx_calculate_hash_last(vm, out + (size_t)(i - 1) * 32);
+            completed = i;
+            break;
+        }
+        randomx_calculate_hash_next(vm, in + (size_t)i * input_size, input_size,
+                                    out + (size_t)(i - 1) * 32);
+    }
+    if (completed == count) {
+        randomx_calculate_hash_last(vm, out + (size_t)(count - 1) * 32);
+    }
+    
+    // Feed the EWMA the per-hash average so batch and single-hash callers
+    // report on the same scale.
+    zion::StatsRegistry::record_stage(stats, 0, (zion::StatsRegistry::now_us() - t0) / completed);
+    stats.hashes.fetch_add(completed, std::memory_order_relaxed);
+    
+    if (vm_lock) vm_lock->unlock();
+    return completed;
+}
+
+/**
+ * Build the cache/dataset for a new key on a background thread
+ * The current VM pool keeps hashing the old key while this runs.
+ * Poll randomx_prepare_ready(), then call randomx_swap_key().
+ * 
+ * @param key New epoch key
+ * @param key_size Size of key in bytes
+ * @return true if the background build was started (or key already pending)
+ */
+extern "C" bool randomx_prepare_key(const void* key, size_t key_size) {
+    if (vm_pool_count.load(std::memory_order_acquire) == 0) {
+        std::cerr << "❌ randomx_prepare_key: call randomx_init() first" << std::endl;
+        return false;
+    }
+    
+    if (pending_in_progress.load()) {
+        std::cout << "⚠️  Key preparation already in progress" << std::endl;
+        return false;
+    }
+    
+    if (numa_replication_active) {
+        // Hot swap would collapse every VM onto one dataset copy and undo the
+        // locality win; with replication enabled, do a full randomx_init().
+        std::cerr << "❌ randomx_prepare_key: not supported with NUMA replication, re-init instead" << std::endl;
+        return false;
+    }
+    
+    std::vector<uint8_t> new_key(
+        static_cast<const uint8_t*>(key),
+        static_cast<const uint8_t*>(key) + key_size
+    );
+    if (new_key == current_key) {
+        std::cout << "⚠️  randomx_prepare_key: key unchanged, nothing to do" << std::endl;
+        return false;
+    }
+    
+    // Discard a previously prepared (but never swapped) key
+    if (pending_ready.exchange(false)) {
+        if (prepare_thread.joinable()) prepare_thread.join();
+        if (pending_dataset) { randomx_release_dataset(pending_dataset); pending_dataset = nullptr; }
+        if (pending_cache) { randomx_release_cache(pending_cache); pending_cache = nullptr; }
+    }
+    if (prepare_thread.joinable()) prepare_thread.join();
+    
+    pending_key = std::move(new_key);
+    pending_flags = pool_vm_flags;
+    pending_in_progress.store(true);
+    
+    prepare_thread = std::thread([]() {
+        std::cout << "⏳ Preparing RandomX cache/dataset for new key in background..." << std::endl;
+        auto start = std::chrono::high_resolution_clock::now();
+        
+        randomx_cache* cache = randomx_alloc_cache(pending_flags);
+        if (!cache) {
+            std::cerr << "❌ Background key prep: cache allocation failed" << std::endl;
+            pending_in_progress.store(false);
+            return;
+        }
+        randomx_init_cache(cache, pending_key.data(), pending_key.size());
+        
+        randomx_dataset* dataset = nullptr;
+        if (pool_have_dataset) {
+            dataset = randomx_alloc_dataset(pending_flags);
+            if (!dataset) {
+                std::cerr << "❌ Background key prep: dataset allocation failed" << std::endl;
+                randomx_release_cache(cache);
+                pending_in_progress.store(false);
+                return;
+            }
+            if (try_load_dataset_cache(dataset, pending_key.data(), pending_key.size())) {
+                std::cout << "✅ Pending dataset restored from cache" << std::endl;
+            } else {
+                // Leave roughly half the machine to the still-hashing VM pool
+                int init_threads = clamp_int((int)std::thread::hardware_concurrency() / 2, 1, 32);
+                init_dataset_multithreaded(dataset, cache, init_threads);
+                save_dataset_cache(dataset, pending_key.data(), pending_key.size());
+            }
+        }
+        
+        pending_cache = cache;
+        pending_dataset = dataset;
+        
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+        std::cout << "✅ New key prepared in " << duration.count() << " ms (call randomx_swap_key)" << std::endl;
+        
+        pending_ready.store(true);
+        pending_in_progress.store(false);
+    });
+    
+    return true;
+}
+
+/**
+ * Check whether a prepared key is ready to swap in
+ */
+extern "C" bool randomx_prepare_ready() {
+    return pending_ready.load();
+}
+
+/**
+ * Atomically switch the VM pool to the prepared key
+ * Repoints every VM at the new cache/dataset and releases the old ones.
+ * Callers should briefly quiesce in-flight hashing around this call; the
+ * swap itself is milliseconds, not the 10-60 s of a full re-init.
+ * 
+ * @return true if the swap happened, false if nothing was prepared
+ */
+extern "C" bool randomx_swap_key() {
+    if (!pending_ready.exchange(false)) {
+        std::cerr << "❌ randomx_swap_key: no prepared key (call randomx_prepare_key first)" << std::endl;
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(init_mutex);
+    if (prepare_thread.joinable()) prepare_thread.join();
+    
+    for (auto slot : vm_pool) {
+        if (!slot || !slot->vm) continue;
+        if (pool_have_dataset && pending_dataset) {
+            randomx_vm_set_dataset(slot->vm, pending_dataset);
+        } else {
+            randomx_vm_set_cache(slot->vm, pending_cache);
+        }
+    }
+    
+    // Retire the old epoch's memory
+    if (global_dataset) randomx_release_dataset(global_dataset);
+    if (global_cache) randomx_release_cache(global_cache);
+    
+    global_cache = pending_cache;
+    global_dataset = pending_dataset;
+    current_key = std::move(pending_key);
+    pending_cache = nullptr;
+    pending_dataset = nullptr;
+    pending_key.clear();
+    
+    std::cout << "✅ RandomX key swapped (VM pool repointed to new dataset)" << std::endl;
+    return true;
+}
+
+/**
+ * Query the VM -> NUMA node assignment so the orchestrator can pin its
+ * worker threads to match the dataset copy each VM reads
+ * 
+ * @param vm_nodes Output array (one node index per VM), may be NULL
+ * @param max_entries Capacity of vm_nodes
+ * @param num_nodes Receives the number of NUMA nodes detected, may be NULL
+ * @return Number of VMs in the pool
+ */
+extern "C" int randomx_get_thread_topology(int* vm_nodes, int max_entries, int* num_nodes) {
+    if (num_nodes) {
+        *num_nodes = numa_node_cpus.empty() ? 1 : (int)numa_node_cpus.size();
+    }
+    if (vm_nodes) {
+        int n = (int)vm_pool_count.load(std::memory_order_acquire);
+        if (n > max_entries) n = max_entries;
+        for (int i = 0; i < n; i++) vm_nodes[i] = vm_node_assignment[i];
+    }
+    return (int)vm_pool_count.load(std::memory_order_acquire);
+}
+
+// MemAvailable from /proc/meminfo, 0 when unreadable
+static uint64_t mem_available_bytes() {
+    std::ifstream meminfo("/proc/meminfo");
+    std::string line;
+    while (std::getline(meminfo, line)) {
+        if (line.rfind("MemAvailable:", 0) == 0) {
+            uint64_t kb = 0;
+            sscanf(line.c_str(), "MemAvailable: %lu", (unsigned long*)&kb);
+            return kb * 1024;
+        }
+    }
+    return 0;
+}
+
+// One calibrated run: `threads` workers each leasing a VM and running the
+// pipelined batch path for `seconds`, returning aggregate H/s.
+static double randomx_tune_measure(int threads, uint32_t batch, double seconds) {
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> hashes{0};
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            if (randomx_register_thread() < 0) return;
+            std::vector<uint8_t> headers((size_t)batch * 80);
+            for (size_t i = 0; i < headers.size(); i++) {
+                headers[i] = (uint8_t)((i * 0x9E3779B9u + t) >> 24);
+            }
+            std::vector<uint8_t> outputs((size_t)batch * 32);
+            while (!stop.load(std::memory_order_relaxed)) {
+                uint32_t done = zion_randomx_hash_batch_raw(-1, headers.data(), 80,
+                                                            batch, outputs.data());
+                hashes.fetch_add(done, std::memory_order_relaxed);
+            }
+            randomx_unregister_thread();
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& w : workers) w.join();
+    return (double)hashes.load() / seconds;
+}
+
+/**
+ * First-run auto-tune (see zion-tune.h)
+ *
+ * Sweeps thread counts with short calibrated runs of the VM pool and
+ * checks whether FULL_MEM is safe to keep: when MemAvailable has no
+ * headroom left over the mapped dataset, the random dataset reads start
+ * paging and fast mode degrades below light mode (the failure mode
+ * get_optimal_flags() warns about) — we flag that from the headroom
+ * instead of thrashing the box to prove it. Call after randomx_init();
+ * the pool grows on demand for counts above the init size.
+ */
+extern "C" int randomx_autotune(int seconds, zion_tune_result* out) {
+    if (!out || seconds < 1) return -1;
+    if (vm_pool_count.load(std::memory_order_acquire) == 0) {
+        std::cerr << "❌ Auto-tune requires randomx_init() first" << std::endl;
+        return -1;
+    }
+
+    const std::vector<int> thread_candidates = zion::tune_thread_candidates();
+    const uint32_t batch = 64;
+    const double slice = (double)seconds / thread_candidates.size();
+
+    std::cout << "⏳ RandomX auto-tune: " << thread_candidates.size()
+              << " thread counts, ~" << seconds << "s total" << std::endl;
+
+    int best_threads = thread_candidates[0];
+    double best_rate = 0.0;
+    for (int threads : thread_candidates) {
+        double rate = randomx_tune_measure(threads, batch, slice);
+        std::cout << "   " << threads << " threads: " << (uint64_t)rate << " H/s" << std::endl;
+        if (rate > best_rate) {
+            best_rate = rate;
+            best_threads = threads;
+        }
+    }
+
+    int full_mem = (pool_vm_flags & RANDOMX_FLAG_FULL_MEM) ? 1 : 0;
+    if (full_mem) {
+        const uint64_t headroom = 512ull * 1024 * 1024;
+        uint64_t avail = mem_available_bytes();
+        if (avail > 0 && avail < headroom) {
+            std::cout << "⚠️  Only " << (avail / (1024 * 1024))
+                      << " MiB available with the dataset mapped — recommending"
+                      << " light mode (ZION_RANDOMX_LIGHT=1)" << std::endl;
+            full_mem = 0;
+        }
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->threads = best_threads;
+    out->batch = batch;
+    out->pin_policy = zion::tune_pin_policy(best_threads);
+    out->full_mem = full_mem;
+    out->hashrate_hs = best_rate;
+    snprintf(out->config_json, sizeof(out->config_json),
+             "{\"algo\":\"randomx\",\"threads\":%d,\"batch\":%u,"
+             "\"pin_policy\":%d,\"full_mem\":%d,\"hashrate_hs\":%.1f}",
+             best_threads, batch, out->pin_policy, full_mem, best_rate);
+
+    std::cout << "✅ Auto-tune winner: " << best_threads << " threads ("
+              << (uint64_t)best_rate << " H/s, "
+              << (full_mem ? "FULL_MEM" : "light mode") << ")" << std::endl;
+    return 0;
 }
 
 /**
  * Get number of VMs in pool (= number of threads)
  */
 extern "C" int randomx_get_num_threads() {
-    return vm_pool.size();
+    return (int)vm_pool_count.load(std::memory_order_acquire);
 }
 
 /**
@@ -346,9 +1181,27 @@ extern "C" int randomx_get_num_threads() {
 extern "C" void randomx_cleanup() {
     std::lock_guard<std::mutex> lock(init_mutex);
     
-    // Cleanup VM pool
-    for (auto vm : vm_pool) {
-        if (vm) randomx_destroy_vm(vm);
+    // Stop any in-flight background key preparation
+    if (prepare_thread.joinable()) prepare_thread.join();
+    pending_ready.store(false);
+    pending_in_progress.store(false);
+    if (pending_dataset) {
+        randomx_release_dataset(pending_dataset);
+        pending_dataset = nullptr;
+    }
+    if (pending_cache) {
+        randomx_release_cache(pending_cache);
+        pending_cache = nullptr;
+    }
+    
+    // Cleanup VM pool (invalidate outstanding thread leases first)
+    pool_generation.fetch_add(1);
+    vm_pool_count.store(0, std::memory_order_release);
+    for (auto slot : vm_pool) {
+        if (slot) {
+            if (slot->vm) randomx_destroy_vm(slot->vm);
+            delete slot;
+        }
     }
     vm_pool.clear();
     
@@ -357,7 +1210,13 @@ extern "C" void randomx_cleanup() {
     }
     vm_mutexes.clear();
     
-    // Cleanup dataset and cache
+    // Cleanup dataset and cache (including NUMA replicas)
+    for (auto replica : numa_datasets) {
+        if (replica) randomx_release_dataset(replica);
+    }
+    numa_datasets.clear();
+    vm_node_assignment.clear();
+    numa_replication_active = false;
     if (global_dataset) {
         randomx_release_dataset(global_dataset);
         global_dataset = nullptr;
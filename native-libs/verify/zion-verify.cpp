@@ -0,0 +1,385 @@
+/**
+ * ZION hash verification and stage-regression gate
+ *
+ * Twice now, silent hash divergence between x86 pool validators and ARM
+ * edge miners (the NEON/SSE Blake3 split, the endianness-sensitive byte
+ * assembly in ZionBig256::from_hash_le) has cost a day of orphaned shares.
+ * This gate makes divergence a build failure instead of a production
+ * incident: a frozen corpus of input→hash vectors is checked through
+ * cosmic_hash, zion_randomx_hash_bytes, and yescrypt_hash_bytes_thread,
+ * and the hot internal stages (galactic_matrix_ops,
+ * golden_matrix_transform, zion_big256_cmp) are microbenchmarked against
+ * a committed timing baseline. Any vector mismatch, or a stage more than
+ * --tolerance slower than its baseline, exits nonzero — correctness at
+ * speed is the contract SIMD rewrites of the mixing stages must meet.
+ *
+ * The corpus inputs are generated in-binary (deterministic patterns), so
+ * the vector file only stores expected hashes. Record them once on a
+ * trusted build with --record, commit the vector file, and every platform
+ * checks against it from then on. The timing baseline is per-host and
+ * stays untracked: record one on each machine the regression budget is
+ * defined for (without one the timing check is report-only).
+ *
+ * Cosmic Harmony is linked directly (the stage entry points are C++);
+ * RandomX and yescrypt load with dlopen() like zion-bench, so the gate
+ * still runs when only some libraries were built.
+ *
+ * Usage:
+ *   zion-verify [--record] [--vectors FILE] [--baseline FILE]
+ *               [--randomx-lib PATH] [--yescrypt-lib PATH]
+ *               [--key HEX] [--tolerance FRACTION]
+ *
+ * @version 2.9.0
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+
+#include "zion-big256.h"
+#include "zion-cosmic-harmony.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace {
+
+// RandomX (librandomx_zion), resolved at runtime
+typedef int (*rx_init_fn)(const char*, int);
+typedef void (*rx_hash_fn)(const uint8_t*, size_t, uint8_t*);
+typedef void (*rx_cleanup_fn)();
+
+// Yescrypt (libyescrypt_zion), resolved at runtime
+typedef int (*ys_init_fn)(int);
+typedef int (*ys_hash_fn)(int, const uint8_t*, size_t, uint8_t*);
+typedef void (*ys_cleanup_fn)();
+
+struct Options {
+    std::string vectors_path = "zion-vectors.txt";
+    std::string baseline_path = "zion-baseline.txt";
+    std::string randomx_lib;
+    std::string yescrypt_lib;
+    std::string key_hex = "5a494f4e2062656e63686d61726b206b6579";  // "ZION benchmark key"
+    double tolerance = 0.05;
+    bool record = false;
+};
+
+const int VECTORS_PER_ALGO = 16;
+
+// Cycle counter: TSC on x86, the fixed-rate virtual counter on AArch64,
+// steady_clock nanoseconds elsewhere. Baselines are per-host either way,
+// so the unit only has to be stable on the machine that recorded them.
+uint64_t cycles_now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t v;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Deterministic corpus inputs — the same generator as zion-bench, varied
+// per vector index so the corpus exercises more than one byte pattern.
+void fill_input(uint8_t* buf, size_t len, uint32_t index) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)((i * 0x9E3779B9u + 0x5A494F4Eu + index * 0x85EBCA6Bu) >> 24);
+    }
+}
+
+std::string to_hex(const uint8_t* bytes, size_t len) {
+    std::ostringstream out;
+    for (size_t i = 0; i < len; i++) {
+        char b[3];
+        snprintf(b, sizeof(b), "%02x", bytes[i]);
+        out << b;
+    }
+    return out.str();
+}
+
+void* must_sym(void* handle, const char* name) {
+    void* sym = dlsym(handle, name);
+    if (!sym) {
+        std::cerr << "❌ Symbol not found: " << name << " (" << dlerror() << ")" << std::endl;
+        exit(1);
+    }
+    return sym;
+}
+
+// ---------------------------------------------------------------------------
+// Hash vectors
+// ---------------------------------------------------------------------------
+
+// Computed hashes for every algorithm a library was supplied for, keyed
+// "algo index" so check and record share one corpus walk.
+std::map<std::string, std::string> compute_vectors(const Options& opt) {
+    std::map<std::string, std::string> hashes;
+    uint8_t input[80];
+    uint8_t hash[32];
+
+    // Cosmic Harmony: direct calls, 76-byte header + explicit nonce
+    zion::CosmicHarmonyHasher::initialize();
+    for (int i = 0; i < VECTORS_PER_ALGO; i++) {
+        fill_input(input, 76, (uint32_t)i);
+        zion::CosmicHarmonyHasher::cosmic_hash(input, 76, 0x5A490000u + i, hash);
+        hashes["cosmic " + std::to_string(i)] = to_hex(hash, 32);
+    }
+
+    if (!opt.randomx_lib.empty()) {
+        // Light mode: the vectors are identical with or without the full
+        // dataset, and the gate shouldn't spend minutes building one.
+        setenv("ZION_RANDOMX_LIGHT", "1", 1);
+        void* handle = dlopen(opt.randomx_lib.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!handle) {
+            std::cerr << "❌ dlopen failed: " << dlerror() << std::endl;
+            exit(1);
+        }
+        auto init = (rx_init_fn)must_sym(handle, "zion_randomx_init");
+        auto hash_bytes = (rx_hash_fn)must_sym(handle, "zion_randomx_hash_bytes");
+        auto cleanup = (rx_cleanup_fn)must_sym(handle, "zion_randomx_cleanup");
+        if (!init(opt.key_hex.c_str(), 1)) {
+            std::cerr << "❌ zion_randomx_init failed" << std::endl;
+            exit(1);
+        }
+        for (int i = 0; i < VECTORS_PER_ALGO; i++) {
+            fill_input(input, 80, (uint32_t)i);
+            hash_bytes(input, 80, hash);
+            hashes["randomx " + std::to_string(i)] = to_hex(hash, 32);
+        }
+        cleanup();
+    }
+
+    if (!opt.yescrypt_lib.empty()) {
+        void* handle = dlopen(opt.yescrypt_lib.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!handle) {
+            std::cerr << "❌ dlopen failed: " << dlerror() << std::endl;
+            exit(1);
+        }
+        auto init = (ys_init_fn)must_sym(handle, "yescrypt_init_mining");
+        auto hash_thread = (ys_hash_fn)must_sym(handle, "yescrypt_hash_bytes_thread");
+        auto cleanup = (ys_cleanup_fn)must_sym(handle, "yescrypt_cleanup");
+        if (init(1) != 0) {
+            std::cerr << "❌ yescrypt_init_mining failed" << std::endl;
+            exit(1);
+        }
+        for (int i = 0; i < VECTORS_PER_ALGO; i++) {
+            fill_input(input, 80, (uint32_t)i);
+            if (hash_thread(0, input, 80, hash) != 0) {
+                std::cerr << "❌ yescrypt hash failed on vector " << i << std::endl;
+                exit(1);
+            }
+            hashes["yescrypt " + std::to_string(i)] = to_hex(hash, 32);
+        }
+        cleanup();
+    }
+
+    return hashes;
+}
+
+// ---------------------------------------------------------------------------
+// Stage microbenchmarks
+// ---------------------------------------------------------------------------
+
+// Defeats dead-code elimination without perturbing the measured loops
+volatile uint64_t g_sink = 0;
+
+// Best-of-five batches of `iters` calls, in counter units per call. Best
+// (not mean) so scheduler noise inflates neither baselines nor checks.
+template <typename Fn>
+double measure_stage(Fn&& fn, int iters) {
+    double best = 0.0;
+    for (int batch = 0; batch < 5; batch++) {
+        uint64_t t0 = cycles_now();
+        for (int i = 0; i < iters; i++) fn();
+        double per_call = (double)(cycles_now() - t0) / iters;
+        if (batch == 0 || per_call < best) best = per_call;
+    }
+    return best;
+}
+
+std::map<std::string, double> run_stage_benchmarks() {
+    std::map<std::string, double> timings;
+
+    uint8_t input[64];
+    fill_input(input, sizeof(input), 0);
+    uint8_t keccak_out[64];
+    uint64_t matrix[8];
+
+    timings["galactic_matrix_ops"] = measure_stage([&]() {
+        zion::CosmicHarmonyHasher::galactic_matrix_ops(input, keccak_out);
+        g_sink += keccak_out[0];
+    }, 2000);
+
+    timings["golden_matrix_transform"] = measure_stage([&]() {
+        zion::CosmicHarmonyHasher::golden_matrix_transform(input, matrix);
+        g_sink += matrix[0];
+    }, 2000);
+
+    uint8_t a_bytes[32], b_bytes[32];
+    fill_input(a_bytes, 32, 1);
+    fill_input(b_bytes, 32, 2);
+    ZionBig256 a = ZionBig256::from_hash_le(a_bytes);
+    ZionBig256 b = ZionBig256::from_hash_le(b_bytes);
+    timings["zion_big256_cmp"] = measure_stage([&]() {
+        g_sink += (uint64_t)zion_big256_cmp(a, b);
+    }, 200000);
+
+    return timings;
+}
+
+// ---------------------------------------------------------------------------
+// File formats: one entry per line, text, diff-friendly.
+//   vectors:  <algo> <index> <hash_hex>
+//   baseline: <stage> <counter_units_per_call>
+// ---------------------------------------------------------------------------
+
+bool load_key_value_file(const std::string& path, std::map<std::string, std::string>& out) {
+    std::ifstream f(path);
+    if (!f.good()) return false;
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        size_t split = line.rfind(' ');
+        if (split == std::string::npos) continue;
+        out[line.substr(0, split)] = line.substr(split + 1);
+    }
+    return true;
+}
+
+void write_file(const std::string& path, const std::string& header,
+                const std::map<std::string, std::string>& entries) {
+    std::ofstream f(path, std::ios::trunc);
+    f << header;
+    for (const auto& kv : entries) {
+        f << kv.first << " " << kv.second << "\n";
+    }
+}
+
+void usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [--record] [--vectors FILE] [--baseline FILE]\n"
+              << "       [--randomx-lib PATH] [--yescrypt-lib PATH]\n"
+              << "       [--key HEX] [--tolerance FRACTION]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) { usage(argv[0]); exit(1); }
+            return argv[++i];
+        };
+        if (arg == "--record") opt.record = true;
+        else if (arg == "--vectors") opt.vectors_path = next();
+        else if (arg == "--baseline") opt.baseline_path = next();
+        else if (arg == "--randomx-lib") opt.randomx_lib = next();
+        else if (arg == "--yescrypt-lib") opt.yescrypt_lib = next();
+        else if (arg == "--key") opt.key_hex = next();
+        else if (arg == "--tolerance") opt.tolerance = atof(next().c_str());
+        else { usage(argv[0]); return 1; }
+    }
+
+    std::cerr << "⏳ Computing hash corpus (cosmic"
+              << (opt.randomx_lib.empty() ? "" : ", randomx")
+              << (opt.yescrypt_lib.empty() ? "" : ", yescrypt") << ")..." << std::endl;
+    std::map<std::string, std::string> hashes = compute_vectors(opt);
+
+    std::cerr << "⏳ Benchmarking stages..." << std::endl;
+    std::map<std::string, double> timings = run_stage_benchmarks();
+
+    if (opt.record) {
+        write_file(opt.vectors_path,
+                   "# ZION frozen hash vectors — recorded by zion-verify --record.\n"
+                   "# Inputs are generated in-binary; entries are <algo> <index> <hash>.\n",
+                   hashes);
+        std::map<std::string, std::string> baseline;
+        for (const auto& kv : timings) {
+            char buf[32];
+            snprintf(buf, sizeof(buf), "%.1f", kv.second);
+            baseline[kv.first] = buf;
+        }
+        write_file(opt.baseline_path,
+                   "# ZION stage timing baseline — counter units per call on the\n"
+                   "# recording host. Entries are <stage> <units_per_call>.\n",
+                   baseline);
+        std::cout << "✅ Recorded " << hashes.size() << " vectors to " << opt.vectors_path
+                  << " and " << timings.size() << " baselines to " << opt.baseline_path
+                  << std::endl;
+        return 0;
+    }
+
+    int failures = 0;
+
+    // Vector check: every expected hash we can recompute must match exactly
+    std::map<std::string, std::string> expected;
+    if (!load_key_value_file(opt.vectors_path, expected)) {
+        std::cerr << "❌ No vector file at " << opt.vectors_path
+                  << " — record one on a trusted build with --record" << std::endl;
+        return 1;
+    }
+    int checked = 0, skipped = 0;
+    for (const auto& kv : expected) {
+        auto it = hashes.find(kv.first);
+        if (it == hashes.end()) {
+            skipped++;  // library for this algo not supplied
+            continue;
+        }
+        checked++;
+        if (it->second != kv.second) {
+            std::cerr << "❌ Hash mismatch [" << kv.first << "]\n"
+                      << "   expected " << kv.second << "\n"
+                      << "   got      " << it->second << std::endl;
+            failures++;
+        }
+    }
+    std::cout << (failures ? "❌ " : "✅ ") << checked << " vectors checked, "
+              << failures << " mismatches" << (skipped ? " (" + std::to_string(skipped)
+              + " skipped, library not supplied)" : "") << std::endl;
+
+    // Stage regression check against the committed baseline
+    std::map<std::string, std::string> baseline;
+    if (load_key_value_file(opt.baseline_path, baseline)) {
+        for (const auto& kv : timings) {
+            auto it = baseline.find(kv.first);
+            if (it == baseline.end()) continue;
+            double base = atof(it->second.c_str());
+            if (base <= 0.0) continue;
+            double ratio = kv.second / base;
+            if (ratio > 1.0 + opt.tolerance) {
+                std::cerr << "❌ Stage regression: " << kv.first << " is "
+                          << (int)((ratio - 1.0) * 100) << "% slower than baseline ("
+                          << kv.second << " vs " << base << ")" << std::endl;
+                failures++;
+            } else {
+                std::cout << "✅ " << kv.first << ": " << kv.second
+                          << " units/call (baseline " << base << ")" << std::endl;
+            }
+        }
+    } else {
+        std::cout << "⚠️  No baseline at " << opt.baseline_path
+                  << " — stage timings reported, not enforced" << std::endl;
+        for (const auto& kv : timings) {
+            std::cout << "   " << kv.first << ": " << kv.second << " units/call" << std::endl;
+        }
+    }
+
+    return failures ? 1 : 0;
+}
@@ -15,16 +15,32 @@
 #endif
 
 // Forward declarations of C++ functions
+#include "zion-cpu.h"
+#include "zion-jobslot.h"
+
 extern "C" {
     int zion_yescrypt_init(uint64_t N, uint32_t r, uint32_t p, int threads);
+    int zion_yescrypt_init_parallel(uint64_t N, uint32_t r, uint32_t p, int lane_threads);
+    int zion_yescrypt_rom_build(const char* path, uint64_t size);
+    int zion_yescrypt_rom_attach(const char* path);
+    struct zion_tune_result;
+    int zion_yescrypt_autotune(int seconds, struct zion_tune_result* out);
     void zion_yescrypt_cleanup();
     int zion_yescrypt_get_num_threads();
     int zion_yescrypt_hash(int thread_id, const uint8_t* data, size_t data_len, uint8_t* output);
     int zion_yescrypt_hash_auto(const uint8_t* data, size_t data_len, uint8_t* output);
     int zion_yescrypt_check_difficulty(const uint8_t* hash, uint64_t difficulty);
+    int zion_yescrypt_search(int thread_id, const uint8_t* header, size_t header_len,
+                             size_t nonce_offset, uint32_t start_nonce, uint32_t count,
+                             const uint8_t* target_be, uint8_t* out_hash, uint32_t* out_nonce,
+                             uint32_t* out_completed);
+    void zion_yescrypt_set_job_generation(uint64_t generation);
     void zion_yescrypt_bytes_to_hex(const uint8_t* bytes, size_t len, char* hex_out);
     const char* zion_yescrypt_version();
     double zion_yescrypt_benchmark(int thread_id, int num_hashes);
+    struct zion_stats;
+    int zion_yescrypt_get_stats(int thread_id, struct zion_stats* out);
+    int zion_yescrypt_get_num_stat_slots();
 }
 
 /**
@@ -58,6 +74,20 @@ extern "C" ZION_EXPORT int yescrypt_init_custom(uint64_t N, uint32_t r, uint32_t
  * @param output Output buffer (must be 32 bytes)
  * @return 0 on success, -1 on error
  */
+/**
+ * Initialize with internal p-lane threading: a single hash spreads its p
+ * lanes across lane_threads OpenMP workers, so total scratch memory stays
+ * one region instead of one per mining thread. For memory-constrained
+ * hosts; high-core boxes should keep yescrypt_init_mining()'s
+ * one-hash-per-thread mode.
+ *
+ * @return 0 on success, -1 on error
+ */
+extern "C" ZION_EXPORT int yescrypt_init_parallel(uint64_t N, uint32_t r, uint32_t p,
+                                                  int lane_threads) {
+    return zion_yescrypt_init_parallel(N, r, p, lane_threads);
+}
+
 extern "C" ZION_EXPORT int yescrypt_hash_bytes(const uint8_t* data, size_t data_len, uint8_t* output) {
     return zion_yescrypt_hash_auto(data, data_len, output);
 }
@@ -104,6 +134,81 @@ extern "C" ZION_EXPORT int yescrypt_hash_hex(const char* hex_data, char* hex_out
     return result;
 }
 
+/**
+ * Zero-copy job buffers (see zion-jobslot.h)
+ *
+ * Same contract as the RandomX wrapper: register a persistent header buffer
+ * once, rewrite it in place, hash by slot index. Replaces the hex-string /
+ * malloc path in yescrypt_hash_hex() for callers on the hot job loop.
+ */
+
+static zion::JobSlotTable g_job_slots;
+
+// Returns the slot index, or -1 when the table is full
+extern "C" ZION_EXPORT int yescrypt_register_job_buffer(const uint8_t* ptr, size_t len) {
+    return g_job_slots.register_buffer(ptr, len);
+}
+
+// Returns 1 on success, 0 for an empty or bad slot
+extern "C" ZION_EXPORT int yescrypt_unregister_job_buffer(int slot) {
+    return g_job_slots.unregister(slot);
+}
+
+// Hash the first data_len bytes of a registered buffer on the given
+// thread's local state. Returns 0 on success like zion_yescrypt_hash(),
+// -1 on a bad slot/length.
+extern "C" ZION_EXPORT int yescrypt_hash_job(int slot, int thread_id, size_t data_len,
+                                             uint8_t* output) {
+    const uint8_t* buf = g_job_slots.resolve(slot, data_len);
+    if (!buf || !output) return -1;
+    return zion_yescrypt_hash(thread_id, buf, data_len, output);
+}
+
+/**
+ * Sweep a nonce range in native code with a full 256-bit target check
+ * Returns 1 on share found (out_hash/out_nonce filled), 0 if exhausted or
+ * aborted by a job switch, -1 on error. out_completed (may be NULL) receives
+ * the number of nonces hashed; below count with no share means the sweep was
+ * aborted by yescrypt_set_job_generation().
+ */
+extern "C" ZION_EXPORT int yescrypt_search(int thread_id, const uint8_t* header, size_t header_len,
+                                           size_t nonce_offset, uint32_t start_nonce, uint32_t count,
+                                           const uint8_t* target_be, uint8_t* out_hash,
+                                           uint32_t* out_nonce, uint32_t* out_completed) {
+    return zion_yescrypt_search(thread_id, header, header_len, nonce_offset,
+                                start_nonce, count, target_be, out_hash, out_nonce,
+                                out_completed);
+}
+
+// Bump when the pool pushes new work: in-flight sweeps abort within one hash
+extern "C" ZION_EXPORT void yescrypt_set_job_generation(uint64_t generation) {
+    zion_yescrypt_set_job_generation(generation);
+}
+
+/**
+ * First-run auto-tune: sweep thread counts against measured H/s and emit
+ * the winning configuration (see zion-tune.h)
+ */
+extern "C" ZION_EXPORT int zion_autotune(int seconds, struct zion_tune_result* out) {
+    return zion_yescrypt_autotune(seconds, out);
+}
+
+/**
+ * Build the ROM-hardened mode's read-only table and persist it (one-time,
+ * multi-GB; see zion_yescrypt_rom_build)
+ */
+extern "C" ZION_EXPORT int yescrypt_rom_build(const char* path, uint64_t size) {
+    return zion_yescrypt_rom_build(path, size);
+}
+
+/**
+ * Map a built ROM file read-only and shared -- every miner process on the
+ * box shares one physical copy. Call after yescrypt_init().
+ */
+extern "C" ZION_EXPORT int yescrypt_rom_attach(const char* path) {
+    return zion_yescrypt_rom_attach(path);
+}
+
 /**
  * Check if hash meets difficulty
  */
@@ -114,6 +219,26 @@ extern "C" ZION_EXPORT int yescrypt_check_difficulty(const uint8_t* hash, uint64
 /**
  * Cleanup resources
  */
+// Detected CPU feature bitmask / readable form (see zion-cpu.h)
+extern "C" ZION_EXPORT uint64_t zion_cpu_features() {
+    return zion::cpu_features();
+}
+
+extern "C" ZION_EXPORT const char* zion_cpu_features_string() {
+    return zion::cpu_features_string();
+}
+
+// Snapshot one worker thread's counters (see zion-stats.h; stage 0 is the
+// full KDF). Returns 0 for an out-of-range thread_id.
+extern "C" ZION_EXPORT int yescrypt_get_stats(int thread_id, struct zion_stats* out) {
+    return zion_yescrypt_get_stats(thread_id, out);
+}
+
+// Number of stats slots handed out so far (= threads that have hashed)
+extern "C" ZION_EXPORT int yescrypt_get_num_stat_slots() {
+    return zion_yescrypt_get_num_stat_slots();
+}
+
 extern "C" ZION_EXPORT void yescrypt_cleanup() {
     zion_yescrypt_cleanup();
 }
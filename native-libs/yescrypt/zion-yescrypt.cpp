@@ -16,6 +16,7 @@
 #include <mutex>
 #include <atomic>
 #include <chrono>
+#include <thread>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -24,6 +25,21 @@ extern "C" {
 #include "yescrypt.h"
 }
 
+#include "zion-big256.h"
+#include "zion-stats.h"
+#include "zion-tune.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // Global state for Yescrypt
 static bool g_initialized = false;
 static yescrypt_shared_t g_shared;
@@ -34,6 +50,75 @@ static int g_num_threads = 1;
 // Mining parameters (optimized for cryptocurrency mining)
 static yescrypt_params_t g_params;
 
+// ROM (NROM) state: when a ROM is attached, g_shared points into a
+// read-only MAP_SHARED mapping of the ROM file, so the miner processes on
+// a box share one physical copy instead of allocating a multi-GB ROM each.
+static bool g_rom_attached = false;
+static void* g_rom_map = nullptr;
+static size_t g_rom_map_size = 0;
+
+// Preallocated per-thread scratch arenas. Without these the yescrypt library
+// mallocs each thread's N*r*128-byte region lazily with 4KiB pages, and the
+// random scratchpad walk hammers the dTLB. We reserve each region up front,
+// huge-page backed where the OS allows (mirroring the large-pages fallback
+// ladder in the RandomX wrapper), and install it into the yescrypt_local_t
+// so yescrypt_kdf() never allocates on the hot path.
+struct ThreadArena {
+    void* base = nullptr;
+    size_t size = 0;
+    bool mapped = false;   // mmap'd (vs malloc fallback)
+    bool huge = false;     // MAP_HUGETLB succeeded
+};
+static std::vector<ThreadArena> g_arenas;
+
+/**
+ * Reserve one thread's scratch region, preferring explicit huge pages,
+ * then transparent huge pages, then plain malloc.
+ */
+static ThreadArena arena_alloc(size_t size) {
+    ThreadArena arena;
+    // Round up to a 2MiB huge-page boundary
+    const size_t HUGE_2M = 2 * 1024 * 1024;
+    size = (size + HUGE_2M - 1) & ~(HUGE_2M - 1);
+    arena.size = size;
+    
+#ifdef __linux__
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) {
+        arena.base = p;
+        arena.mapped = true;
+        arena.huge = true;
+        return arena;
+    }
+    
+    p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p != MAP_FAILED) {
+        madvise(p, size, MADV_HUGEPAGE);
+        arena.base = p;
+        arena.mapped = true;
+        return arena;
+    }
+#endif
+    
+    arena.base = malloc(size);
+    return arena;
+}
+
+static void arena_free(ThreadArena& arena) {
+    if (!arena.base) return;
+#ifdef __linux__
+    if (arena.mapped) {
+        munmap(arena.base, arena.size);
+        arena.base = nullptr;
+        return;
+    }
+#endif
+    free(arena.base);
+    arena.base = nullptr;
+}
+
 /**
  * Initialize Yescrypt with specified parameters
  * 
@@ -66,14 +151,33 @@ extern "C" int zion_yescrypt_init(uint64_t N, uint32_t r, uint32_t p, int thread
     // Initialize shared structure (NULL for no ROM in mining)
     memset(&g_shared, 0, sizeof(g_shared));
     
-    // Allocate thread-local structures
+    // Scratch needed per hash: V (128*r*N) plus XY/B/S working areas.
+    // A little slack is fine; the arena is rounded to 2MiB anyway.
+    size_t scratch_size = (size_t)128 * r * N + (size_t)128 * r * (4 + p) + (size_t)12288 * p;
+    
+    // Allocate thread-local structures with preallocated arenas
+    int huge_count = 0;
     g_locals.resize(g_num_threads);
+    g_arenas.resize(g_num_threads);
     for (int i = 0; i < g_num_threads; i++) {
         g_locals[i] = new yescrypt_local_t;
         if (yescrypt_init_local(g_locals[i]) != 0) {
             std::cerr << "Failed to initialize thread-local structure " << i << std::endl;
             return -1;
         }
+        
+        g_arenas[i] = arena_alloc(scratch_size);
+        if (g_arenas[i].base) {
+            // Install the arena so yescrypt_kdf() sees a big-enough region
+            // and never reallocates. Touch it once so page faults happen
+            // here, on the first-touch thread, not mid-hash.
+            memset(g_arenas[i].base, 0, g_arenas[i].size);
+            g_locals[i]->base = g_arenas[i].base;
+            g_locals[i]->aligned = g_arenas[i].base;
+            g_locals[i]->base_size = g_arenas[i].size;
+            g_locals[i]->aligned_size = g_arenas[i].size;
+            if (g_arenas[i].huge) huge_count++;
+        }
     }
     
     g_initialized = true;
@@ -82,8 +186,249 @@ extern "C" int zion_yescrypt_init(uint64_t N, uint32_t r, uint32_t p, int thread
     std::cout << "   Parameters: N=" << N << ", r=" << r << ", p=" << p << std::endl;
     std::cout << "   Threads: " << g_num_threads << std::endl;
     std::cout << "   Mode: YESCRYPT_RW (ASIC-resistant)" << std::endl;
+    std::cout << "   Scratch: " << (scratch_size / 1024) << " KiB/thread preallocated, "
+              << huge_count << "/" << g_num_threads << " huge-page backed" << std::endl;
+    
+    return 0;
+}
+
+/**
+ * Initialize for internal p-lane parallelism
+ *
+ * The standard mining mode (p=1, one independent hash per thread)
+ * multiplies scratch memory by thread count. This wires up the other mode
+ * the library supports: p>1, with the upstream yescrypt code dispatching
+ * the p lanes of each single hash across an OpenMP pool (yescrypt-opt.c
+ * parallelizes its lane loop under _OPENMP, which the build enables with
+ * -fopenmp). One local state, one scratch region sized for all p lanes,
+ * and a single hash finishing ~lane_threads times faster — the right
+ * trade for memory-constrained edge miners.
+ *
+ * @param N Memory cost parameter (power of 2)
+ * @param r Block size parameter
+ * @param p Lane count (the parallelism inside each hash)
+ * @param lane_threads OpenMP threads to spread the lanes over
+ * @return 0 on success, -1 on error
+ */
+extern "C" int zion_yescrypt_init_parallel(uint64_t N, uint32_t r, uint32_t p, int lane_threads) {
+    if (p < 1) p = 1;
+    if (lane_threads < 1) lane_threads = 1;
+    
+    // One outer caller at a time in this mode; the cores go to the lanes.
+    int rc = zion_yescrypt_init(N, r, p, 1);
+    if (rc != 0) return rc;
+    
+#ifdef _OPENMP
+    omp_set_num_threads(lane_threads);
+    std::cout << "✅ Yescrypt p-lane threading: " << p << " lanes over "
+              << lane_threads << " OpenMP threads" << std::endl;
+#else
+    if (lane_threads > 1) {
+        std::cout << "⚠️  Built without OpenMP: p=" << p
+                  << " lanes will run sequentially" << std::endl;
+    }
+#endif
+    
+    return 0;
+}
+
+/**
+ * ROM (NROM) support
+ *
+ * The chain spec's ROM-hardened mode mixes a large read-only table into
+ * every hash. Building it is a one-time, minutes-long job, so we persist
+ * it: zion_yescrypt_rom_build() computes the ROM and writes it to a file,
+ * zion_yescrypt_rom_attach() maps that file read-only and shared and wires
+ * it into g_shared/NROM so every subsequent yescrypt_kdf() call uses it.
+ * Attach is cheap and per-process; the kernel keeps one physical copy for
+ * all of them.
+ *
+ * File layout: one header page (so the ROM data that follows stays page
+ * aligned for mmap), then the raw ROM blocks.
+ */
+struct RomFileHeader {
+    char magic[4];      // "ZYRM"
+    uint32_t version;   // 1
+    uint64_t rom_bytes; // ROM data bytes following the header page
+    uint64_t NROM;      // block count (power of two)
+    uint32_t r;         // block size the ROM was built for
+    uint32_t flags;     // yescrypt flags the ROM was built with
+};
+static const size_t ROM_HEADER_PAGE = 4096;
+static const char ROM_SEED[] = "ZION_YESCRYPT_ROM_V1";
+
+/**
+ * Build the ROM and persist it to a file
+ *
+ * size is rounded down to a power-of-two count of 128*r-byte ROM blocks
+ * (yescrypt requires NROM to be a power of two). The library initializes
+ * the ROM with p parallel lanes, which -fopenmp spreads across cores --
+ * the same mechanism zion_yescrypt_init_parallel() uses for hashing.
+ * Written tmp-then-rename so a crashed build never leaves a torn file
+ * that a later attach would trust.
+ *
+ * @param path Destination file
+ * @param size Target ROM size in bytes (rounded down to a valid NROM)
+ * @return 0 on success, -1 on error
+ */
+extern "C" int zion_yescrypt_rom_build(const char* path, uint64_t size) {
+#ifdef __linux__
+    if (!path || !*path) return -1;
+    
+    const uint32_t r = g_initialized ? g_params.r : 8;
+    const uint64_t block_bytes = 128ull * r;
+    if (size < block_bytes) {
+        std::cerr << "ROM size " << size << " below one " << block_bytes
+                  << "-byte block" << std::endl;
+        return -1;
+    }
+    uint64_t nrom = 1;
+    while (nrom * 2 * block_bytes <= size) nrom <<= 1;
+    
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) cpus = 1;
+    
+    yescrypt_params_t rom_params;
+    memset(&rom_params, 0, sizeof(rom_params));
+    rom_params.flags = g_initialized ? g_params.flags : YESCRYPT_DEFAULTS;
+    rom_params.N = nrom;
+    rom_params.r = r;
+    rom_params.p = (uint32_t)cpus;  // parallel lanes for the init
+    rom_params.NROM = nrom;
+    
+    std::cout << "⏳ Building yescrypt ROM: " << (nrom * block_bytes / (1024 * 1024))
+              << " MiB (NROM=" << nrom << ", r=" << r << ", " << cpus
+              << " lanes)..." << std::endl;
+    
+    yescrypt_shared_t rom;
+    memset(&rom, 0, sizeof(rom));
+    if (yescrypt_init_shared(&rom, (const uint8_t*)ROM_SEED, sizeof(ROM_SEED) - 1,
+                             &rom_params) != 0) {
+        std::cerr << "❌ yescrypt_init_shared failed" << std::endl;
+        return -1;
+    }
+    
+    RomFileHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, "ZYRM", 4);
+    hdr.version = 1;
+    hdr.rom_bytes = rom.aligned_size;
+    hdr.NROM = nrom;
+    hdr.r = r;
+    hdr.flags = (uint32_t)rom_params.flags;
+    
+    std::string tmp_path = std::string(path) + ".tmp." + std::to_string(getpid());
+    FILE* f = fopen(tmp_path.c_str(), "wb");
+    if (!f) {
+        std::cerr << "❌ Cannot create " << tmp_path << std::endl;
+        yescrypt_free_shared(&rom);
+        return -1;
+    }
+    
+    uint8_t header_page[ROM_HEADER_PAGE] = {0};
+    memcpy(header_page, &hdr, sizeof(hdr));
+    bool ok = fwrite(header_page, 1, ROM_HEADER_PAGE, f) == ROM_HEADER_PAGE;
+    
+    // Stream in 64MiB chunks so a multi-GB ROM doesn't double-buffer
+    const size_t CHUNK = 64 * 1024 * 1024;
+    const uint8_t* src = (const uint8_t*)rom.aligned;
+    for (size_t off = 0; ok && off < rom.aligned_size; off += CHUNK) {
+        size_t len = rom.aligned_size - off < CHUNK ? rom.aligned_size - off : CHUNK;
+        ok = fwrite(src + off, 1, len, f) == len;
+    }
+    ok = (fclose(f) == 0) && ok;
+    yescrypt_free_shared(&rom);
+    
+    if (!ok || rename(tmp_path.c_str(), path) != 0) {
+        std::cerr << "❌ Failed to write ROM file " << path << std::endl;
+        remove(tmp_path.c_str());
+        return -1;
+    }
+    
+    std::cout << "✅ Yescrypt ROM written: " << path << std::endl;
+    return 0;
+#else
+    (void)path; (void)size;
+    std::cerr << "ROM files are only supported on Linux" << std::endl;
+    return -1;
+#endif
+}
+
+/**
+ * Map a previously built ROM file and wire it into hashing
+ *
+ * Maps the ROM read-only with MAP_SHARED (one physical copy per box,
+ * whatever the miner process count) and MAP_POPULATE (fault it in now,
+ * not across the first million hashes), then points g_shared at the
+ * mapping and sets NROM so yescrypt_kdf() mixes it in. Call after
+ * zion_yescrypt_init(); the ROM's r must match the mining parameters.
+ *
+ * @param path ROM file written by zion_yescrypt_rom_build()
+ * @return 0 on success, -1 on error
+ */
+extern "C" int zion_yescrypt_rom_attach(const char* path) {
+#ifdef __linux__
+    std::lock_guard<std::mutex> lock(g_init_mutex);
+    
+    if (!g_initialized) {
+        std::cerr << "Yescrypt not initialized" << std::endl;
+        return -1;
+    }
+    if (g_rom_attached) {
+        std::cout << "⚠️  Yescrypt ROM already attached (skipping)" << std::endl;
+        return 0;
+    }
+    if (!path) return -1;
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "❌ Cannot open ROM file " << path << std::endl;
+        return -1;
+    }
+    
+    RomFileHeader hdr;
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        pread(fd, &hdr, sizeof(hdr), 0) != (ssize_t)sizeof(hdr) ||
+        memcmp(hdr.magic, "ZYRM", 4) != 0 || hdr.version != 1 ||
+        (uint64_t)st.st_size < ROM_HEADER_PAGE + hdr.rom_bytes) {
+        std::cerr << "❌ Invalid ROM file " << path << std::endl;
+        close(fd);
+        return -1;
+    }
+    if (hdr.r != g_params.r) {
+        std::cerr << "❌ ROM built for r=" << hdr.r << ", miner runs r="
+                  << g_params.r << std::endl;
+        close(fd);
+        return -1;
+    }
+    
+    void* map = mmap(nullptr, (size_t)hdr.rom_bytes, PROT_READ,
+                     MAP_SHARED | MAP_POPULATE, fd, (off_t)ROM_HEADER_PAGE);
+    close(fd);
+    if (map == MAP_FAILED) {
+        std::cerr << "❌ Cannot map ROM file " << path << std::endl;
+        return -1;
+    }
+    
+    g_rom_map = map;
+    g_rom_map_size = (size_t)hdr.rom_bytes;
+    g_shared.base = map;
+    g_shared.aligned = map;
+    g_shared.base_size = g_rom_map_size;
+    g_shared.aligned_size = g_rom_map_size;
+    g_params.NROM = hdr.NROM;
+    g_rom_attached = true;
     
+    std::cout << "✅ Yescrypt ROM attached: " << path << " ("
+              << (hdr.rom_bytes / (1024 * 1024)) << " MiB shared, NROM="
+              << hdr.NROM << ")" << std::endl;
     return 0;
+#else
+    (void)path;
+    std::cerr << "ROM files are only supported on Linux" << std::endl;
+    return -1;
+#endif
 }
 
 /**
@@ -96,14 +441,36 @@ extern "C" void zion_yescrypt_cleanup() {
         return;
     }
     
-    // Free thread-local structures
-    for (auto* local : g_locals) {
-        if (local) {
-            yescrypt_free_local(local);
-            delete local;
+    // Free thread-local structures. Where we installed an arena, detach it
+    // first so yescrypt_free_local() doesn't free memory it doesn't own.
+    for (int i = 0; i < (int)g_locals.size(); i++) {
+        yescrypt_local_t* local = g_locals[i];
+        if (!local) continue;
+        if (i < (int)g_arenas.size() && g_arenas[i].base) {
+            local->base = nullptr;
+            local->aligned = nullptr;
+            local->base_size = 0;
+            local->aligned_size = 0;
         }
+        yescrypt_free_local(local);
+        delete local;
     }
     g_locals.clear();
+    for (auto& arena : g_arenas) {
+        arena_free(arena);
+    }
+    g_arenas.clear();
+    
+#ifdef __linux__
+    if (g_rom_attached) {
+        munmap(g_rom_map, g_rom_map_size);
+        g_rom_map = nullptr;
+        g_rom_map_size = 0;
+        memset(&g_shared, 0, sizeof(g_shared));
+        g_params.NROM = 0;
+        g_rom_attached = false;
+    }
+#endif
     
     g_initialized = false;
     std::cout << "Yescrypt cleanup complete" << std::endl;
@@ -125,6 +492,27 @@ extern "C" int zion_yescrypt_get_num_threads() {
  * @param output Output buffer (32 bytes)
  * @return 0 on success, -1 on error
  */
+// Job generation counter: bumped by the orchestrator on new work; the
+// search loop polls it between hashes (each ~1ms) and aborts promptly.
+static std::atomic<uint64_t> g_job_generation{0};
+
+extern "C" void zion_yescrypt_set_job_generation(uint64_t generation) {
+    g_job_generation.store(generation, std::memory_order_relaxed);
+}
+
+// Per-thread hashrate counters (stage 0 = full KDF; see zion-stats.h). A
+// yescrypt hash takes around a millisecond, so timing every call costs
+// nothing relative to the work being measured.
+static zion::StatsRegistry g_stats;
+
+extern "C" int zion_yescrypt_get_stats(int thread_id, zion_stats* out) {
+    return g_stats.read(thread_id, out);
+}
+
+extern "C" int zion_yescrypt_get_num_stat_slots() {
+    return g_stats.num_slots();
+}
+
 extern "C" int zion_yescrypt_hash(int thread_id, const uint8_t* data, size_t data_len, uint8_t* output) {
     if (!g_initialized) {
         std::cerr << "Yescrypt not initialized" << std::endl;
@@ -141,9 +529,12 @@ extern "C" int zion_yescrypt_hash(int thread_id, const uint8_t* data, size_t dat
     // No salt for mining (deterministic from data)
     uint8_t salt[32] = {0};
     
+    zion::ThreadStats& stats = g_stats.slot_for_thread();
+    double t0 = zion::StatsRegistry::now_us();
+    
     // Compute hash (use NULL, not nullptr for C library)
     int result = yescrypt_kdf(
-        NULL,             // shared (no ROM for mining)
+        g_rom_attached ? &g_shared : NULL,  // ROM when attached
         local,            // thread-local
         data, data_len,   // password
         salt, 32,         // salt
@@ -153,6 +544,9 @@ extern "C" int zion_yescrypt_hash(int thread_id, const uint8_t* data, size_t dat
     
     if (result != 0) {
         std::cerr << "yescrypt_kdf failed with code " << result << std::endl;
+    } else {
+        zion::StatsRegistry::record_stage(stats, 0, zion::StatsRegistry::now_us() - t0);
+        stats.hashes.fetch_add(1, std::memory_order_relaxed);
     }
     
     return result;
@@ -168,6 +562,73 @@ extern "C" int zion_yescrypt_hash_auto(const uint8_t* data, size_t data_len, uin
     return zion_yescrypt_hash(thread_id, data, data_len, output);
 }
 
+/**
+ * In-native nonce search with a full 256-bit target check
+ * 
+ * Patches the nonce into a local copy of the header, hashes, and
+ * short-circuits as soon as a hash meets the big-endian target -- one FFI
+ * call per sweep, and a precise comparison instead of the truncated 64-bit
+ * check in zion_yescrypt_check_difficulty() (which misclassifies shares on
+ * variable-difficulty pools).
+ * 
+ * @param thread_id Thread ID (0 to num_threads-1)
+ * @param header Block header template
+ * @param header_len Length of header in bytes
+ * @param nonce_offset Byte offset of the 4-byte nonce within the header
+ * @param start_nonce First nonce to try
+ * @param count Number of nonces to sweep
+ * @param target_be 32-byte big-endian share target
+ * @param out_hash Receives the winning 32-byte hash
+ * @param out_nonce Receives the winning nonce
+ * @param out_completed Optional; receives the number of nonces hashed. Below
+ *                      count with no share means the sweep was aborted by
+ *                      zion_yescrypt_set_job_generation()
+ * @return 1 if a share was found, 0 if the range was exhausted or the sweep
+ *         aborted on a job switch, -1 on error
+ */
+extern "C" int zion_yescrypt_search(int thread_id, const uint8_t* header, size_t header_len,
+                                    size_t nonce_offset, uint32_t start_nonce, uint32_t count,
+                                    const uint8_t* target_be, uint8_t* out_hash,
+                                    uint32_t* out_nonce, uint32_t* out_completed) {
+    if (!g_initialized) {
+        std::cerr << "Yescrypt not initialized" << std::endl;
+        return -1;
+    }
+    if (!header || !target_be || !out_hash || !out_nonce) return -1;
+    if (nonce_offset + 4 > header_len) return -1;
+    
+    std::vector<uint8_t> work(header, header + header_len);
+    ZionTarget target = ZionTarget::from_be_bytes(target_be);
+    const uint64_t entry_gen = g_job_generation.load(std::memory_order_relaxed);
+    
+    uint8_t hash[32];
+    for (uint32_t i = 0; i < count; i++) {
+        if (g_job_generation.load(std::memory_order_relaxed) != entry_gen) {
+            if (out_completed) *out_completed = i;
+            return 0;
+        }
+        
+        uint32_t nonce = start_nonce + i;
+        memcpy(work.data() + nonce_offset, &nonce, 4);
+        
+        if (zion_yescrypt_hash(thread_id, work.data(), header_len, hash) != 0) {
+            if (out_completed) *out_completed = i;
+            return -1;
+        }
+        
+        if (target.check(hash)) {
+            g_stats.slot_for_thread().shares.fetch_add(1, std::memory_order_relaxed);
+            memcpy(out_hash, hash, 32);
+            *out_nonce = nonce;
+            if (out_completed) *out_completed = i + 1;
+            return 1;
+        }
+    }
+    
+    if (out_completed) *out_completed = count;
+    return 0;
+}
+
 /**
  * Check if hash meets difficulty target
  * Returns 1 if hash < target, 0 otherwise
@@ -233,3 +694,97 @@ extern "C" double zion_yescrypt_benchmark(int thread_id, int num_hashes) {
     double hashes_per_sec = (num_hashes * 1000.0) / duration;
     return hashes_per_sec;
 }
+
+// One calibrated run: `threads` workers, each on its own local state and
+// scratch arena, hashing until the deadline. Returns aggregate H/s.
+static double yescrypt_tune_measure(int threads, double seconds) {
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> hashes{0};
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            uint8_t header[80];
+            for (int i = 0; i < 80; i++) {
+                header[i] = (uint8_t)((i * 0x9E3779B9u + t) >> 24);
+            }
+            uint8_t hash[32];
+            uint32_t nonce = (uint32_t)t << 24;
+            while (!stop.load(std::memory_order_relaxed)) {
+                memcpy(header + 76, &nonce, 4);
+                if (zion_yescrypt_hash(t, header, 80, hash) != 0) return;
+                nonce++;
+                hashes.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& w : workers) w.join();
+    return (double)hashes.load() / seconds;
+}
+
+/**
+ * First-run auto-tune (see zion-tune.h)
+ *
+ * Sweeps thread counts with short calibrated runs against the thread-local
+ * states and returns the winner as fields plus ready-to-persist JSON.
+ * Initializes with mining defaults (N=4096, r=8, p=1) over all logical
+ * CPUs when the caller hasn't initialized yet; candidates above the
+ * initialized thread count are skipped since each worker needs its own
+ * scratch arena.
+ *
+ * @param seconds Total tuning budget, split across the candidate runs
+ * @param out Receives the winning configuration
+ * @return 0 on success, -1 on error
+ */
+extern "C" int zion_yescrypt_autotune(int seconds, zion_tune_result* out) {
+    if (!out || seconds < 1) return -1;
+    
+    if (!g_initialized) {
+        long cpus = std::thread::hardware_concurrency();
+        if (cpus < 1) cpus = 1;
+        if (zion_yescrypt_init(4096, 8, 1, (int)cpus) != 0) return -1;
+    }
+    
+    std::vector<int> thread_candidates = zion::tune_thread_candidates();
+    thread_candidates.erase(
+        std::remove_if(thread_candidates.begin(), thread_candidates.end(),
+                       [](int n) { return n > g_num_threads; }),
+        thread_candidates.end());
+    if (thread_candidates.empty()) thread_candidates.push_back(g_num_threads);
+    
+    const double slice = (double)seconds / thread_candidates.size();
+    
+    std::cout << "⏳ Yescrypt auto-tune: " << thread_candidates.size()
+              << " thread counts, ~" << seconds << "s total" << std::endl;
+    
+    int best_threads = thread_candidates[0];
+    double best_rate = 0.0;
+    for (int threads : thread_candidates) {
+        double rate = yescrypt_tune_measure(threads, slice);
+        std::cout << "   " << threads << " threads: " << rate << " H/s" << std::endl;
+        if (rate > best_rate) {
+            best_rate = rate;
+            best_threads = threads;
+        }
+    }
+    
+    memset(out, 0, sizeof(*out));
+    out->threads = best_threads;
+    out->batch = 1;  // ~1ms per hash; batching is moot
+    out->pin_policy = zion::tune_pin_policy(best_threads);
+    out->full_mem = 0;
+    out->hashrate_hs = best_rate;
+    snprintf(out->config_json, sizeof(out->config_json),
+             "{\"algo\":\"yescrypt\",\"threads\":%d,\"N\":%llu,\"r\":%u,\"p\":%u,"
+             "\"pin_policy\":%d,\"hashrate_hs\":%.1f}",
+             best_threads, (unsigned long long)g_params.N, g_params.r, g_params.p,
+             out->pin_policy, best_rate);
+    
+    std::cout << "✅ Auto-tune winner: " << best_threads << " threads ("
+              << best_rate << " H/s)" << std::endl;
+    return 0;
+}